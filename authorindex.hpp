@@ -0,0 +1,125 @@
+#ifndef _AUTHORINDEX_H
+#define _AUTHORINDEX_H
+
+// -----------------------------------------------------------------------------
+// Library Catalog Project — AuthorIndex (ordered author -> books lookup).
+// findAuthor's default "contains" search goes through the word index; the
+// front desk mostly knows the author, though, and wants either that exact
+// author or everyone whose name starts with what was typed (findAuthor
+// --exact / --prefix). Keeping the
+// distinct authors in an ordered map answers both with one O(log n) seek plus
+// a walk over the k matching entries.
+// Authors are normalized first (ASCII lowercase, runs of spaces/tabs collapsed,
+// ends trimmed), so "DAWKINS,  richard" and "Dawkins, Richard" are one author.
+// I use inline functions so that the function definitions inside the header file don’t cause linker errors when the header is included in multiple source files
+// Source: https://stackoverflow.com/questions/5057021/why-do-inline-functions-have-to-be-defined-in-a-header-file
+// -----------------------------------------------------------------------------
+
+#include <string>        // normalized keys
+#include <map>           // ordered: prefix queries are one contiguous range
+#include <unordered_map> // book -> slot in its author's bucket
+#include "myvector.hpp"  // books per author
+#include "book.hpp"      // Book model
+
+using namespace std;
+
+class AuthorIndex
+{
+	private:
+		// Normalized author -> every book by that author
+		map<string, MyVector<Book*> > byAuthor;
+
+		// Book -> its position inside its author's bucket (for O(1) removal)
+		unordered_map<const Book*, int> slots;
+
+		// Reused key buffer so add/remove don't allocate for known authors
+		string keyScratch;
+
+	public:
+		// Lowercase ASCII, collapse whitespace runs to one space, trim the ends
+		static void normalize(const string& author, string& out);
+
+		// Register / unregister a book under its current author
+		void add(Book* book);
+		void remove(Book* book);
+
+		// Forget everything
+		void clear();
+
+		// Books whose normalized author equals / starts with the normalized query (appended to 'out')
+		void exact(const string& author, MyVector<Book*>& out) const;
+		void prefix(const string& start, MyVector<Book*>& out) const;
+};
+
+// ============================================================================
+// AuthorIndex methods
+// ============================================================================
+
+inline void AuthorIndex::normalize(const string& author, string& out) {
+	out.clear();
+	bool pendingSpace = false;
+	for (size_t i = 0; i < author.size(); ++i) {
+		char c = author[i];
+		if (c == ' ' || c == '\t') {
+			pendingSpace = out.size() > 0;
+			continue;
+		}
+		if (pendingSpace) out += ' ';
+		pendingSpace = false;
+		out += (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+	}
+}
+
+inline void AuthorIndex::add(Book* book) {
+	normalize(book->getAuthor(), keyScratch);
+	MyVector<Book*>& books = byAuthor[keyScratch];
+	slots[book] = (int)books.size();
+	books.push_back(book);
+}
+
+// Move the bucket's last book into the freed slot (callers sort results into
+// catalog order), and drop the entry once its last book is gone so prefix
+// walks stay tight
+inline void AuthorIndex::remove(Book* book) {
+	unordered_map<const Book*, int>::iterator slot = slots.find(book);
+	if (slot == slots.end()) return;
+	normalize(book->getAuthor(), keyScratch);
+	map<string, MyVector<Book*> >::iterator it = byAuthor.find(keyScratch);
+	if (it == byAuthor.end()) return;
+
+	MyVector<Book*>& books = it->second;
+	int last = (int)books.size() - 1;
+	int at = slot->second;
+	if (at != last) slots[books[last]] = at;
+	books.swap_remove((size_t)at);
+	slots.erase(slot);
+	if (books.empty()) byAuthor.erase(it);
+}
+
+inline void AuthorIndex::clear() {
+	byAuthor.clear();
+	slots.clear();
+}
+
+inline void AuthorIndex::exact(const string& author, MyVector<Book*>& out) const {
+	string key;
+	normalize(author, key);
+	map<string, MyVector<Book*> >::const_iterator it = byAuthor.find(key);
+	if (it == byAuthor.end()) return;
+	out.insert(out.end(), it->second.begin(), it->second.end());
+}
+
+// Every key starting with 'key' sits in one run beginning at lower_bound(key)
+inline void AuthorIndex::prefix(const string& start, MyVector<Book*>& out) const {
+	string key;
+	normalize(start, key);
+	map<string, MyVector<Book*> >::const_iterator it = byAuthor.lower_bound(key);
+	for (; it != byAuthor.end() && it->first.compare(0, key.size(), key) == 0; ++it) {
+		out.insert(out.end(), it->second.begin(), it->second.end());
+	}
+}
+
+// -----------------------------------------------------------------------------
+// End guard: keep headers clean and avoid accidental extra code below.
+// -----------------------------------------------------------------------------
+#endif
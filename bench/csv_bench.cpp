@@ -0,0 +1,170 @@
+//============================================================================
+// Name         : csv_bench.cpp
+// Description  : Microbenchmark for the CSV row tokenizer used by import.
+//
+// Compares the original char-by-char parser (copied below as it was before
+// the scanner existed) against csvScanRow with the scalar, SSE2 and AVX2
+// scanners. Input is booklist.csv-shaped: the sample rows are repeated
+// until the buffer reaches the requested size.
+//
+// Build & run from the repo root:
+//   g++ -std=c++11 -O2 -o csv_bench bench/csv_bench.cpp
+//   ./csv_bench [csv_file] [megabytes]      (defaults: booklist.csv, 64)
+//============================================================================
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "../myvector.hpp"
+#include "../csv.hpp"
+
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// Reference: the parser LCMS::import used before csv.hpp (one byte at a time,
+// growing the field with += and copying it again through trim).
+// -----------------------------------------------------------------------------
+static string legacyTrim(const string& s) {
+	int start = 0;
+	while (start < (int)s.size() && (s[start] == ' ' || s[start] == '\t')) start++;
+	int end = (int)s.size() - 1;
+	while (end >= start && (s[end] == ' ' || s[end] == '\t')) end--;
+	if (end < start) return "";
+	return s.substr(start, end - start + 1);
+}
+
+static bool legacyParseCSVLine(const string& line, MyVector<string>& fieldsOut) {
+	fieldsOut.clear();
+	string cur = "";
+	bool inQuotes = false;
+
+	for (int i = 0; i < (int)line.size(); ++i) {
+		char c = line[i];
+		if (inQuotes) {
+			if (c == '"') {
+				if (i + 1 < (int)line.size() && line[i + 1] == '"') {
+					cur += '"'; i++;
+				} else {
+					inQuotes = false;
+				}
+			} else {
+				cur += c;
+			}
+		} else {
+			if (c == ',') {
+				fieldsOut.push_back(legacyTrim(cur));
+				cur = "";
+			} else if (c == '"') {
+				inQuotes = true;
+			} else {
+				cur += c;
+			}
+		}
+	}
+	fieldsOut.push_back(legacyTrim(cur));
+	return fieldsOut.size() == 5;
+}
+
+// -----------------------------------------------------------------------------
+// Timing helpers
+// -----------------------------------------------------------------------------
+static double secondsSince(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static void report(const string& name, size_t bytes, double seconds, long rows) {
+	double mbps = (double)bytes / (1024.0 * 1024.0) / seconds;
+	cout << "  " << name;
+	for (size_t i = name.size(); i < 28; ++i) cout << ' ';
+	cout << seconds * 1000.0 << " ms   " << mbps << " MiB/s   (" << rows << " rows)" << endl;
+}
+
+// Old path: getline-style line cut + legacy parser producing strings
+static long runLegacy(const string& data) {
+	long rows = 0;
+	MyVector<string> fields;
+	size_t start = 0;
+	while (start < data.size()) {
+		size_t nl = data.find('\n', start);
+		if (nl == string::npos) nl = data.size();
+		string line = data.substr(start, nl - start);
+		if (legacyParseCSVLine(line, fields)) rows++;
+		start = nl + 1;
+	}
+	return rows;
+}
+
+// New path: views only, or views plus copying every field into a string
+static long runScanner(const string& data, bool materialize) {
+	long rows = 0;
+	CSVField fields[5];
+	string value;
+	const char* p = data.data();
+	const char* end = p + data.size();
+	while (p < end) {
+		int count = csvScanRow(p, end, fields, 5, &p);
+		if (count != 5) continue;
+		if (materialize) {
+			for (int i = 0; i < 5; ++i) csvFieldAssign(fields[i], value);
+		}
+		rows++;
+	}
+	return rows;
+}
+
+int main(int argc, char** argv) {
+	string samplePath = (argc > 1) ? argv[1] : "booklist.csv";
+	size_t megabytes = (argc > 2) ? (size_t)atoi(argv[2]) : 64;
+
+	MappedFile sample;
+	if (!sample.open(samplePath) || sample.size() == 0) {
+		cout << "Could not read " << samplePath << endl;
+		return 1;
+	}
+
+	// Drop the header row and repeat the body up to the target size
+	string body(sample.data(), sample.size());
+	size_t firstNewline = body.find('\n');
+	if (body.compare(0, 6, "Title,") == 0 && firstNewline != string::npos) body = body.substr(firstNewline + 1);
+	if (body.size() == 0 || body[body.size() - 1] != '\n') body += '\n';
+
+	string data;
+	data.reserve(megabytes * 1024 * 1024 + body.size());
+	while (data.size() < megabytes * 1024 * 1024) data += body;
+
+	cout << "Input: " << data.size() / (1024 * 1024) << " MiB of " << samplePath << "-shaped rows" << endl;
+	cout << "Runtime scanner: " << csvScannerName() << endl;
+
+	chrono::steady_clock::time_point t = chrono::steady_clock::now();
+	long rows = runLegacy(data);
+	report("legacy parser", data.size(), secondsSince(t), rows);
+
+	struct Variant { const char* name; _csv_FindFn fn; };
+	Variant variants[3] = {
+		{ "scalar", _csv_findSpecialScalar },
+#ifdef LCMS_CSV_X86_SIMD
+		{ "sse2", _csv_findSpecialSSE2 },
+		{ "avx2", __builtin_cpu_supports("avx2") ? _csv_findSpecialAVX2 : nullptr },
+#else
+		{ "sse2", nullptr },
+		{ "avx2", nullptr },
+#endif
+	};
+
+	_csv_FindFn picked = _csv_activeFinder();
+	for (int v = 0; v < 3; ++v) {
+		if (variants[v].fn == nullptr) continue;
+		_csv_activeFinder() = variants[v].fn;
+
+		t = chrono::steady_clock::now();
+		rows = runScanner(data, false);
+		report(string("scanner/") + variants[v].name + " (views)", data.size(), secondsSince(t), rows);
+
+		t = chrono::steady_clock::now();
+		rows = runScanner(data, true);
+		report(string("scanner/") + variants[v].name + " (strings)", data.size(), secondsSince(t), rows);
+	}
+	_csv_activeFinder() = picked;
+	return 0;
+}
@@ -9,12 +9,55 @@
 // I need std::string for the text fields and std::cout for printBook().
 #include <string>
 #include <iostream>
+#include <stdint.h>   // packed ISBN keys
+#include "stringpool.hpp" // authors are interned
 
 // Pull only what I actually use into scope
 using std::string;
 using std::cout;
 using std::endl;
 
+// -----------------------------------------------------------------------------
+// isbnToKey: normalize an ISBN into one 64-bit number (0 = not a usable ISBN).
+// Hyphens and spaces are ignored; a valid ISBN-10 is converted to its ISBN-13
+// ("0-14-044913-X" style -> 978 + 9 digits + new check digit), and 13 digits
+// are packed as-is. So the same book spelled with or without hyphens, or as
+// ISBN-10 vs ISBN-13, gets one key, and comparing two ISBNs is one integer
+// compare. Anything else (wrong length, bad ISBN-10 check digit, letters)
+// returns 0 and callers fall back to the raw text.
+// -----------------------------------------------------------------------------
+inline uint64_t isbnToKey(const string& text) {
+	int digits[13];
+	int n = 0;
+	for (size_t i = 0; i < text.size(); ++i) {
+		char c = text[i];
+		if (c == '-' || c == ' ') continue;
+		if (n == 13) return 0;
+		if (c >= '0' && c <= '9') digits[n++] = c - '0';
+		else if ((c == 'X' || c == 'x') && n == 9) digits[n++] = 10; // ISBN-10 check digit only
+		else return 0;
+	}
+
+	if (n == 10) {
+		int sum = 0;
+		for (int i = 0; i < 10; ++i) sum += (10 - i) * digits[i];
+		if (sum % 11 != 0) return 0;
+
+		// 978 prefix + the first nine digits, then the ISBN-13 check digit
+		for (int i = 8; i >= 0; --i) digits[i + 3] = digits[i];
+		digits[0] = 9; digits[1] = 7; digits[2] = 8;
+		int weighted = 0;
+		for (int i = 0; i < 12; ++i) weighted += digits[i] * ((i % 2) ? 3 : 1);
+		digits[12] = (10 - weighted % 10) % 10;
+	} else if (n != 13 || digits[9] == 10) {
+		return 0;
+	}
+
+	uint64_t key = 0;
+	for (int i = 0; i < 13; ++i) key = key * 10 + (uint64_t)digits[i];
+	return key;
+}
+
 // -----------------------------------------------------------------------------
 // Book: holds the minimal info I need across the whole program.
 // Title/Author/ISBN are strings; Year is an int (can handle negative years in data).
@@ -28,11 +71,15 @@ class Book
 		string title;
 
 		// Keep author as one string so multi-author cases stay intact (e.g., "A; B").
-		string author;
+		// Interned: books by the same author share one copy of the text.
+		uint32_t authorId;
 
 		// If present, I treat ISBN as the primary identifier for equality.
 		string isbn;
 
+		// isbnToKey(isbn), refreshed whenever the ISBN is set (0 if it is not a usable ISBN)
+		uint64_t isbnKey;
+
 		// Year is an int so I can parse simple numeric input directly.
 		int publication_year;
 
@@ -41,18 +88,27 @@ class Book
 		Book();
 
 		// Full constructor: quick way to create a ready-to-use Book in one shot.
-		Book(string t, string a, string i, int y);
+		Book(const string& t, const string& a, const string& i, int y);
+
+		// Copies share the interned author (one more pool reference); the
+		// destructor drops this book's reference.
+		Book(const Book& other);
+		Book& operator=(const Book& other);
+		~Book();
 
-		// Getters: read-only access to internals (no copies of big objects).
-		string getTitle() const;
-		string getAuthor() const;
-		string getISBN() const;
+		// Getters: read-only access to internals (references, so no string copies).
+		const string& getTitle() const;
+		const string& getAuthor() const;
+		uint32_t getAuthorId() const;
+		const string& getISBN() const;
+		uint64_t getISBNKey() const;
 		int getYear()  const;
 
 		// Setters: used by the edit menu in LCMS (to update fields safely).
-		void setTitle(string t);
-		void setAuthor(string a);
-		void setISBN(string i);
+		// Taking const refs lets a reused Book keep its string capacity.
+		void setTitle(const string& t);
+		void setAuthor(const string& a);
+		void setISBN(const string& i);
 		void setYear(int y);
 
 		// Equality: prefer ISBN if both have it; otherwise fall back to (title, author, year).
@@ -71,8 +127,9 @@ class Book
 // -----------------------------------------------------------------------------
 inline Book::Book() {
 	title = "";
-	author = "";
+	authorId = 0;
 	isbn = "";
+	isbnKey = 0;
 	publication_year = 0;
 }
 
@@ -80,41 +137,77 @@ inline Book::Book() {
 // Parameterized constructor: initialize all fields right away.
 // Handy when importing or creating from user prompts in one go.
 // -----------------------------------------------------------------------------
-inline Book::Book(string t, string a, string i, int y) {
+inline Book::Book(const string& t, const string& a, const string& i, int y) {
 	title = t;
-	author = a;
+	authorId = stringPool().intern(a);
 	isbn = i;
+	isbnKey = isbnToKey(i);
 	publication_year = y;
 }
 
+// -----------------------------------------------------------------------------
+// Copy / assign / destroy: every Book holds one pool reference to its author,
+// so an author disappears from the pool with the last book that names it.
+// -----------------------------------------------------------------------------
+inline Book::Book(const Book& other)
+	: title(other.title), authorId(other.authorId), isbn(other.isbn),
+	  isbnKey(other.isbnKey), publication_year(other.publication_year) {
+	stringPool().retain(authorId);
+}
+
+inline Book& Book::operator=(const Book& other) {
+	if (authorId != other.authorId) {
+		stringPool().retain(other.authorId);
+		stringPool().release(authorId);
+		authorId = other.authorId;
+	}
+	title = other.title;
+	isbn = other.isbn;
+	isbnKey = other.isbnKey;
+	publication_year = other.publication_year;
+	return *this;
+}
+
+inline Book::~Book() {
+	stringPool().release(authorId);
+}
+
 // -----------------------------------------------------------------------------
 // Getters: simple pass-through access. Marked const so they work on const objects.
 // -----------------------------------------------------------------------------
-inline string Book::getTitle() const { return title; }
-inline string Book::getAuthor() const { return author; }
-inline string Book::getISBN()   const { return isbn; }
+inline const string& Book::getTitle() const { return title; }
+inline const string& Book::getAuthor() const { return stringPool().text(authorId); }
+inline uint32_t Book::getAuthorId()    const { return authorId; }
+inline const string& Book::getISBN()   const { return isbn; }
+inline uint64_t Book::getISBNKey()     const { return isbnKey; }
 inline int    Book::getYear()   const { return publication_year; }
 
 // -----------------------------------------------------------------------------
 // Setters: straightforward field updates used by the edit flow.
 // -----------------------------------------------------------------------------
-inline void Book::setTitle(string t) { title = t; }
-inline void Book::setAuthor(string a){ author = a; }
-inline void Book::setISBN(string i)  { isbn = i; }
+inline void Book::setTitle(const string& t) { title = t; }
+inline void Book::setAuthor(const string& a) {
+	uint32_t id = stringPool().intern(a);
+	stringPool().release(authorId);
+	authorId = id;
+}
+inline void Book::setISBN(const string& i)  { isbn = i; isbnKey = isbnToKey(i); }
 inline void Book::setYear(int y)     { publication_year = y; }
 
 // -----------------------------------------------------------------------------
 // Equality rule:
 // - If either side lacks an ISBN, fall back to (title && author && year).
-// - If both have ISBNs, compare just the ISBNs (treat as the main key).
+// - If both have ISBNs, compare just the ISBNs (treat as the main key):
+//   the packed keys when either side has one, else the raw text.
 // This covers older/sparse data while still respecting ISBN when present.
 // -----------------------------------------------------------------------------
 inline bool Book::operator==(const Book& other) const {
 	if (isbn == "" || other.isbn == "") {
 		return (title == other.title &&
-		        author == other.author &&
+		        authorId == other.authorId &&
 		        publication_year == other.publication_year);
 	}
+	if (isbnKey != 0 || other.isbnKey != 0) return isbnKey == other.isbnKey;
 	return isbn == other.isbn;
 }
 
@@ -124,7 +217,7 @@ inline bool Book::operator==(const Book& other) const {
 // -----------------------------------------------------------------------------
 inline void Book::printBook() const {
 	cout << "Title: " << title << endl;
-	cout << "Author: " << author << endl;
+	cout << "Author: " << getAuthor() << endl;
 	cout << "ISBN: " << isbn << endl;
 	cout << "Publication Year: " << publication_year << endl;
 }
@@ -135,19 +228,18 @@ inline void Book::printBook() const {
 // quoteCSV(field) wraps a value in double quotes and doubles any inner quotes.
 // Example:  Hello "World"  ->  "Hello ""World"""
 // This keeps commas/quotes in titles/authors safe for CSV consumers.
+// One pass into a pre-sized string (inserting in place was O(n^2) on quote-heavy text).
 // -----------------------------------------------------------------------------
 inline string quoteCSV(const string& field) {
-	string safe = field;
-
-	// Walk through the string and double any existing quotes.
-	size_t pos = 0;
-	while ((pos = safe.find('"', pos)) != string::npos) {
-		safe.insert(pos, "\"");
-		pos += 2; // Skip past the doubled quotes we just inserted.
+	string safe;
+	safe.reserve(field.size() + 2);
+	safe += '"';
+	for (size_t i = 0; i < field.size(); ++i) {
+		if (field[i] == '"') safe += '"'; // double any existing quote
+		safe += field[i];
 	}
-
-	// Wrap the final text in quotes for CSV.
-	return "\"" + safe + "\"";
+	safe += '"';
+	return safe;
 }
 
 // -----------------------------------------------------------------------------
@@ -156,7 +248,7 @@ inline string quoteCSV(const string& field) {
 // -----------------------------------------------------------------------------
 inline string Book::toCSV() const {
 	return quoteCSV(title) + "," +
-	       quoteCSV(author) + "," +
+	       quoteCSV(getAuthor()) + "," +
 	       quoteCSV(isbn) + "," +
 	       std::to_string(publication_year);
 }
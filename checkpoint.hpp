@@ -0,0 +1,216 @@
+#ifndef _CHECKPOINT_H
+#define _CHECKPOINT_H
+
+// -----------------------------------------------------------------------------
+// Library Catalog Project — Background checkpoint writer.
+// A checkpoint turns "base snapshot + long journal" back into "new snapshot +
+// short journal". Encoding the catalog is O(catalog), and the Tree is not
+// thread-safe, so it must not run on the command thread while commands wait,
+// nor on another thread while the tree changes. On POSIX, start() forks at the
+// command boundary instead: the child gets a copy-on-write image of the process
+// (a frozen view of the tree as of this journal position), encodes and writes
+// the snapshot from it and exits, while the command loop carries on at once.
+// The writer thread waits for the child and then deletes the retired journal
+// segment the new snapshot replaces. Where fork() is not available the image
+// is encoded on the command thread and this thread writes it instead.
+// I use inline functions so that the function definitions inside the header file don’t cause linker errors when the header is included in multiple source files
+// Source: https://stackoverflow.com/questions/5057021/why-do-inline-functions-have-to-be-defined-in-a-header-file
+// -----------------------------------------------------------------------------
+
+#include <string>               // image + paths
+#include <cstdio>               // remove() for the retired journal
+#include <thread>               // the writer thread
+#include <mutex>                // guards the job slot
+#include <condition_variable>   // wakes the writer / waiters
+#include "snapshot.hpp"         // snapshotEncode / snapshotWriteFile (temp file + fsync + rename + directory fsync)
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LCMS_HAVE_FORK 1
+#include <cerrno>        // EINTR
+#include <unistd.h>      // fork / _exit
+#include <sys/wait.h>    // waitpid
+#endif
+
+using namespace std;
+
+class Checkpointer
+{
+	private:
+		thread* worker;            // started on the first start()
+		mutex lock;
+		condition_variable wake;   // a job arrived or stop was requested
+		condition_variable idle;   // the current job finished
+
+		// Job slot (one checkpoint at a time): the child writing the snapshot,
+		// or (without fork) the encoded image to write
+		bool hasJob;
+		bool busy;
+		bool stopping;
+#ifdef LCMS_HAVE_FORK
+		pid_t child;
+#else
+		string image;
+#endif
+		string snapshotPath;
+		string retiredJournal;
+
+		// Outcome of the last finished job, until takeFailure() reads it
+		bool failed;
+
+		void run();
+
+	public:
+		Checkpointer();
+		~Checkpointer();
+
+		Checkpointer(const Checkpointer&) = delete;
+		Checkpointer& operator=(const Checkpointer&) = delete;
+
+		// Snapshot 'tree' as it is now (stamped with 'journalSeq') to 'path' in the
+		// background; once it is on disk, 'retired' (may be empty) is deleted.
+		// Call between commands. False if a checkpoint is still running or the
+		// background copy could not be started.
+		bool start(const Tree& tree, uint64_t journalSeq, const string& path, const string& retired);
+
+		// True while a submitted checkpoint has not finished
+		bool isBusy();
+
+		// Block until the running checkpoint (if any) is done
+		void waitIdle();
+
+		// True (once) if the last checkpoint could not be written
+		bool takeFailure();
+};
+
+// ============================================================================
+// Checkpointer methods
+// ============================================================================
+
+inline Checkpointer::Checkpointer() {
+	worker = nullptr;
+#ifdef LCMS_HAVE_FORK
+	child = -1;
+#endif
+	hasJob = false;
+	busy = false;
+	stopping = false;
+	failed = false;
+}
+
+// Finish the job in flight (it may be the only copy of recent work), then stop
+inline Checkpointer::~Checkpointer() {
+	if (worker == nullptr) return;
+	{
+		lock_guard<mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_one();
+	worker->join();
+	delete worker;
+	worker = nullptr;
+}
+
+// Only the command thread starts jobs, so 'busy' cannot change between the check and the hand-over
+inline bool Checkpointer::start(const Tree& tree, uint64_t journalSeq, const string& path, const string& retired) {
+	if (isBusy()) return false;
+
+#ifdef LCMS_HAVE_FORK
+	// The child only encodes and writes; _exit skips destructors and stdio
+	// flushes that belong to the parent (journal buffers, cout). It must never
+	// unwind back into the command loop (it shares stdin and the journal), so
+	// any exception, e.g. bad_alloc while pages are being copied, ends it too.
+	pid_t pid = fork();
+	if (pid < 0) return false;
+	if (pid == 0) {
+		bool ok = false;
+		try {
+			string encoded;
+			snapshotEncode(tree, encoded, journalSeq);
+			ok = snapshotWriteFile(encoded, path);
+		} catch (...) {
+			ok = false;
+		}
+		_exit(ok ? 0 : 1);
+	}
+#else
+	string encoded;
+	snapshotEncode(tree, encoded, journalSeq);
+#endif
+
+	{
+		lock_guard<mutex> guard(lock);
+#ifdef LCMS_HAVE_FORK
+		child = pid;
+#else
+		image.swap(encoded);
+#endif
+		snapshotPath = path;
+		retiredJournal = retired;
+		hasJob = true;
+		busy = true;
+	}
+	if (worker == nullptr) worker = new thread(&Checkpointer::run, this);
+	wake.notify_one();
+	return true;
+}
+
+inline bool Checkpointer::isBusy() {
+	lock_guard<mutex> guard(lock);
+	return busy;
+}
+
+inline void Checkpointer::waitIdle() {
+	unique_lock<mutex> guard(lock);
+	while (busy) idle.wait(guard);
+}
+
+inline bool Checkpointer::takeFailure() {
+	lock_guard<mutex> guard(lock);
+	bool result = failed;
+	failed = false;
+	return result;
+}
+
+// Writer loop: waits (or writes) outside the lock so start()/isBusy() never wait on disk
+inline void Checkpointer::run() {
+	unique_lock<mutex> guard(lock);
+	while (true) {
+		while (!hasJob && !stopping) wake.wait(guard);
+		if (!hasJob) return; // stopping with nothing left to write
+
+		hasJob = false;
+#ifdef LCMS_HAVE_FORK
+		pid_t pid = child;
+		child = -1;
+#else
+		string job;
+		job.swap(image);
+		string path = snapshotPath;
+#endif
+		string retired = retiredJournal;
+		guard.unlock();
+
+		// The snapshot must be durable before the journal records it replaces go away
+#ifdef LCMS_HAVE_FORK
+		int status = 0;
+		pid_t done;
+		do {
+			done = waitpid(pid, &status, 0);
+		} while (done < 0 && errno == EINTR);
+		bool ok = done == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#else
+		bool ok = snapshotWriteFile(job, path);
+#endif
+		if (ok && retired.size() > 0) remove(retired.c_str());
+
+		guard.lock();
+		failed = !ok;
+		busy = false;
+		idle.notify_all();
+	}
+}
+
+// -----------------------------------------------------------------------------
+// End guard: keep headers clean and avoid accidental extra code below.
+// -----------------------------------------------------------------------------
+#endif
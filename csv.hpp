@@ -0,0 +1,508 @@
+#ifndef _CSV_H
+#define _CSV_H
+
+// -----------------------------------------------------------------------------
+// Library Catalog Project — CSV helpers for import and export.
+// MappedFile maps the whole CSV into memory (mmap on POSIX, one bulk read
+// elsewhere), and the row tokenizer hands back fields as views into that buffer.
+// Nothing is copied until the caller decides a row is worth keeping.
+// CSVWriter is the export counterpart: it formats rows into one big buffer
+// and writes it out in large blocks. fsyncParentDir sits here with the other
+// POSIX file calls; the snapshot and journal writers use it.
+// I use inline functions so that the function definitions inside the header file don’t cause linker errors when the header is included in multiple source files
+// Source: https://stackoverflow.com/questions/5057021/why-do-inline-functions-have-to-be-defined-in-a-header-file
+// -----------------------------------------------------------------------------
+
+#include <string>     // decoded field values
+#include <cstring>    // memchr for the quoted-field fast path
+#include <cstddef>    // size_t
+#include <fstream>    // bulk-read fallback when mmap is not available
+#include <ostream>    // CSVWriter sink
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LCMS_HAVE_MMAP 1
+#include <fcntl.h>     // open
+#include <unistd.h>    // close
+#include <sys/mman.h>  // mmap / munmap / madvise
+#include <sys/stat.h>  // fstat for the file size
+#endif
+
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// MappedFile: read-only view of a whole file.
+// Owns either an mmap'd region or a heap buffer; both are released in close().
+// -----------------------------------------------------------------------------
+class MappedFile
+{
+	private:
+		// First byte of the file contents (nullptr when empty/closed)
+		const char* bytes;
+
+		// Number of bytes in the file
+		size_t length;
+
+		// True if 'bytes' came from mmap (else it is a new[] buffer or nullptr)
+		bool mapped;
+
+		// Fallback: slurp the file with one read into a heap buffer
+		bool readWhole(const string& path);
+
+	public:
+		MappedFile();
+		~MappedFile();
+
+		// A mapping has exactly one owner
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Map (or read) the file; false if it cannot be opened
+		bool open(const string& path);
+
+		// Unmap / free and go back to the empty state
+		void close();
+
+		const char* data() const;
+		size_t size() const;
+};
+
+// -----------------------------------------------------------------------------
+// CSVField: one field of a row, as a view into the row's bytes.
+// When the field is plain (no quotes) or simply "quoted" (no "" escapes),
+// [data, data + size) is already the trimmed value. Otherwise needsDecode is
+// set and [raw, rawEnd) must be decoded with csvFieldAssign().
+// -----------------------------------------------------------------------------
+struct CSVField
+{
+	const char* data;
+	int size;
+	const char* raw;
+	const char* rawEnd;
+	bool needsDecode;
+};
+
+// Scan one row starting at 'begin'. The row ends at the first newline (quoted
+// or not, like getline) or at 'end'; a '\r' before the newline is dropped.
+// Stores at most maxFields views, sets *next to the start of the following
+// row, and returns how many fields the row really has (may be > maxFields).
+int csvScanRow(const char* begin, const char* end, CSVField* fields, int maxFields, const char** next);
+
+// First '"', ',' or '\n' in [p, end), or end. Vectorized where the CPU allows.
+const char* csvFindSpecial(const char* p, const char* end);
+
+// Name of the scanner picked at runtime ("avx2", "sse2" or "scalar")
+const char* csvScannerName();
+
+// Copy a field's value into 'out' (decodes "" escapes when needed).
+void csvFieldAssign(const CSVField& field, string& out);
+
+// ============================================================================
+// MappedFile methods
+// ============================================================================
+
+inline MappedFile::MappedFile() {
+	bytes = nullptr;
+	length = 0;
+	mapped = false;
+}
+
+inline MappedFile::~MappedFile() {
+	close();
+}
+
+inline const char* MappedFile::data() const { return bytes; }
+inline size_t MappedFile::size() const { return length; }
+
+// Prefer mmap so the kernel streams pages in; fall back to a bulk read if
+// the platform has no mmap or the path is not a regular file (e.g. a pipe).
+inline bool MappedFile::open(const string& path) {
+	close();
+#ifdef LCMS_HAVE_MMAP
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+
+	struct stat st;
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+		if (st.st_size == 0) { ::close(fd); return true; } // empty file: nothing to map
+		void* region = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (region != MAP_FAILED) {
+			::close(fd); // the mapping stays valid after the descriptor is closed
+			madvise(region, (size_t)st.st_size, MADV_SEQUENTIAL);
+			bytes = (const char*)region;
+			length = (size_t)st.st_size;
+			mapped = true;
+			return true;
+		}
+	}
+	::close(fd);
+#endif
+	return readWhole(path);
+}
+
+inline bool MappedFile::readWhole(const string& path) {
+	ifstream fin(path.c_str(), ios::in | ios::binary);
+	if (!fin.is_open()) return false;
+
+	string contents((istreambuf_iterator<char>(fin)), istreambuf_iterator<char>());
+	if (contents.size() == 0) return true;
+
+	char* buffer = new char[contents.size()];
+	memcpy(buffer, contents.data(), contents.size());
+	bytes = buffer;
+	length = contents.size();
+	return true;
+}
+
+inline void MappedFile::close() {
+	if (bytes != nullptr) {
+#ifdef LCMS_HAVE_MMAP
+		if (mapped) munmap((void*)bytes, length);
+		else delete [] bytes;
+#else
+		delete [] bytes;
+#endif
+	}
+	bytes = nullptr;
+	length = 0;
+	mapped = false;
+}
+
+// -----------------------------------------------------------------------------
+// fsyncParentDir: Make a rename / create / unlink in the directory holding
+// 'path' durable. fsync on a file only covers its bytes; the directory entry
+// that points at it is a separate write that a power loss can undo (or apply
+// out of order with a later unlink). Without POSIX directory handles this is
+// a no-op that reports success.
+// -----------------------------------------------------------------------------
+inline bool fsyncParentDir(const string& path) {
+#ifdef LCMS_HAVE_MMAP
+	size_t slash = path.find_last_of('/');
+	string dir = (slash == string::npos) ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+	int fd = ::open(dir.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+	bool ok = fsync(fd) == 0;
+	::close(fd);
+	return ok;
+#else
+	(void)path;
+	return true;
+#endif
+}
+
+// ============================================================================
+// Special-character scanner
+// The tokenizer only cares about three bytes: '"', ',' and '\n'. Instead of
+// branching on every byte, these helpers compare 16 (SSE2) or 32 (AVX2) bytes
+// at once and jump straight to the next interesting one. The AVX2 version is
+// compiled with a target attribute and only used if the CPU reports AVX2.
+// ============================================================================
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define LCMS_CSV_X86_SIMD 1
+#include <immintrin.h> // SSE2 / AVX2 intrinsics
+#endif
+
+// Signature shared by every scanner implementation
+typedef const char* (*_csv_FindFn)(const char* p, const char* end);
+
+inline bool _csv_isSpecial(char c) {
+	return c == '"' || c == ',' || c == '\n';
+}
+
+// Plain byte loop: used on other CPUs and for the tail of the SIMD versions
+inline const char* _csv_findSpecialScalar(const char* p, const char* end) {
+	while (p < end && !_csv_isSpecial(*p)) p++;
+	return p;
+}
+
+#ifdef LCMS_CSV_X86_SIMD
+__attribute__((target("sse2")))
+inline const char* _csv_findSpecialSSE2(const char* p, const char* end) {
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i comma = _mm_set1_epi8(',');
+	const __m128i newline = _mm_set1_epi8('\n');
+	while (end - p >= 16) {
+		__m128i v = _mm_loadu_si128((const __m128i*)p);
+		__m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, comma)),
+		                            _mm_cmpeq_epi8(v, newline));
+		int mask = _mm_movemask_epi8(hits);
+		if (mask != 0) return p + __builtin_ctz((unsigned)mask);
+		p += 16;
+	}
+	return _csv_findSpecialScalar(p, end);
+}
+
+__attribute__((target("avx2")))
+inline const char* _csv_findSpecialAVX2(const char* p, const char* end) {
+	const __m256i quote = _mm256_set1_epi8('"');
+	const __m256i comma = _mm256_set1_epi8(',');
+	const __m256i newline = _mm256_set1_epi8('\n');
+	while (end - p >= 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)p);
+		__m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, comma)),
+		                               _mm256_cmpeq_epi8(v, newline));
+		unsigned mask = (unsigned)_mm256_movemask_epi8(hits);
+		if (mask != 0) return p + __builtin_ctz(mask);
+		p += 32;
+	}
+	return _csv_findSpecialSSE2(p, end);
+}
+#endif
+
+// Pick the widest scanner this CPU supports (runs once)
+inline _csv_FindFn _csv_pickFinder() {
+#ifdef LCMS_CSV_X86_SIMD
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) return _csv_findSpecialAVX2;
+	if (__builtin_cpu_supports("sse2")) return _csv_findSpecialSSE2;
+#endif
+	return _csv_findSpecialScalar;
+}
+
+// The active scanner; a reference so benchmarks can swap in another one
+inline _csv_FindFn& _csv_activeFinder() {
+	static _csv_FindFn finder = _csv_pickFinder();
+	return finder;
+}
+
+inline const char* csvFindSpecial(const char* p, const char* end) {
+	return _csv_activeFinder()(p, end);
+}
+
+inline const char* csvScannerName() {
+	_csv_FindFn f = _csv_activeFinder();
+#ifdef LCMS_CSV_X86_SIMD
+	if (f == _csv_findSpecialAVX2) return "avx2";
+	if (f == _csv_findSpecialSSE2) return "sse2";
+#endif
+	(void)f;
+	return "scalar";
+}
+
+// ============================================================================
+// Row tokenizer
+// Same rules as the old char-by-char parser: quotes toggle quoted mode, ""
+// inside quotes is a literal quote, commas only split outside quotes, and
+// each value is trimmed of spaces/tabs after decoding. The scanner above
+// lets the loop skip plain text instead of testing every byte.
+// ============================================================================
+
+// Shrink [b, e) past leading/trailing spaces and tabs
+inline void _csv_trimSpan(const char*& b, const char*& e) {
+	while (b < e && (*b == ' ' || *b == '\t')) b++;
+	while (e > b && (e[-1] == ' ' || e[-1] == '\t')) e--;
+}
+
+// Turn a raw field span into a view when no decoding is required
+inline void _csv_finishField(CSVField& f, const char* b, const char* e, bool sawQuote) {
+	f.raw = b;
+	f.rawEnd = e;
+	f.needsDecode = false;
+
+	if (sawQuote) {
+		// Common case: optional blanks, "text without quotes", optional blanks
+		const char* qb = b;
+		const char* qe = e;
+		_csv_trimSpan(qb, qe);
+		bool simple = (qe - qb >= 2 && *qb == '"' && qe[-1] == '"' &&
+		               memchr(qb + 1, '"', (size_t)(qe - qb - 2)) == nullptr);
+		if (!simple) {
+			f.needsDecode = true;
+			f.data = b;
+			f.size = (int)(e - b);
+			return;
+		}
+		b = qb + 1;
+		e = qe - 1;
+	}
+	_csv_trimSpan(b, e);
+	f.data = b;
+	f.size = (int)(e - b);
+}
+
+inline int csvScanRow(const char* begin, const char* end, CSVField* fields, int maxFields, const char** next) {
+	int count = 0;
+	const char* fieldStart = begin;
+	bool inQuotes = false;
+	bool sawQuote = false;
+	const char* lineEnd = end;
+	*next = end;
+
+	// Hop from one special byte to the next; everything in between is field text
+	const char* p = csvFindSpecial(begin, end);
+	while (p < end) {
+		char c = *p;
+		if (c == '\n') {
+			lineEnd = p;
+			*next = p + 1;
+			break;
+		}
+		if (c == '"') {
+			sawQuote = true;
+			if (inQuotes && p + 1 < end && p[1] == '"') p++; // escaped quote stays inside
+			else inQuotes = !inQuotes;
+		} else if (!inQuotes) { // ','
+			if (count < maxFields) _csv_finishField(fields[count], fieldStart, p, sawQuote);
+			count++;
+			fieldStart = p + 1;
+			sawQuote = false;
+		}
+		p = csvFindSpecial(p + 1, end);
+	}
+
+	// CRLF: the '\r' is part of the line ending, not of the last field
+	if (lineEnd > fieldStart && lineEnd[-1] == '\r') lineEnd--;
+	if (count < maxFields) _csv_finishField(fields[count], fieldStart, lineEnd, sawQuote);
+	return count + 1;
+}
+
+inline void csvFieldAssign(const CSVField& field, string& out) {
+	if (!field.needsDecode) {
+		out.assign(field.data, (size_t)field.size);
+		return;
+	}
+
+	// Slow path: rebuild the value exactly like the old parser did
+	out.clear();
+	bool inQuotes = false;
+	for (const char* p = field.raw; p < field.rawEnd; ++p) {
+		char c = *p;
+		if (c == '"') {
+			if (inQuotes && p + 1 < field.rawEnd && p[1] == '"') { out += '"'; p++; }
+			else inQuotes = !inQuotes;
+		} else {
+			out += c;
+		}
+	}
+
+	const char* b = out.data();
+	const char* e = b + out.size();
+	_csv_trimSpan(b, e);
+	size_t offset = (size_t)(b - out.data());
+	size_t kept = (size_t)(e - b);
+	out.erase(0, offset);
+	out.resize(kept);
+}
+
+// ============================================================================
+// CSVWriter: export side.
+// Rows are formatted straight into one large reusable buffer (no temporary
+// strings per field) and handed to the stream in big blocks. With no stream
+// the writer just accumulates, so callers can format into memory first.
+// ============================================================================
+class CSVWriter
+{
+	private:
+		// Destination (nullptr = keep everything in 'buffer')
+		ostream* sink;
+
+		// Pending bytes not yet handed to the sink
+		string buffer;
+
+		// Flush once the buffer grows past this many bytes
+		size_t blockSize;
+
+	public:
+		// 1 MiB blocks by default: few write calls, still cache friendly
+		explicit CSVWriter(ostream* sink, size_t blockSize = 1 << 20);
+
+		// Flushes whatever is still pending
+		~CSVWriter();
+
+		// Append bytes as-is
+		void appendRaw(const char* data, size_t size);
+		void appendRaw(const string& text);
+		void appendChar(char c);
+
+		// Append "field" with inner quotes doubled, in one linear pass
+		void appendQuoted(const string& field);
+
+		// Append a decimal integer without going through to_string
+		void appendInt(int value);
+
+		// Finish a row and flush if the block is full
+		void endRow();
+
+		// Write a block that was formatted elsewhere (flushes pending bytes first)
+		void appendBlock(const string& block);
+
+		// Hand all pending bytes to the sink (no-op for in-memory writers)
+		void flush();
+
+		// Bytes formatted but not yet flushed (the whole output for in-memory writers)
+		const string& pending() const;
+
+		// Move the pending bytes into 'out' (no copy) and start over empty
+		void takePending(string& out);
+};
+
+inline CSVWriter::CSVWriter(ostream* sink, size_t blockSize) {
+	this->sink = sink;
+	this->blockSize = blockSize;
+	if (sink != nullptr) buffer.reserve(blockSize + 4096);
+}
+
+inline CSVWriter::~CSVWriter() {
+	flush();
+}
+
+inline void CSVWriter::appendRaw(const char* data, size_t size) { buffer.append(data, size); }
+inline void CSVWriter::appendRaw(const string& text)           { buffer.append(text); }
+inline void CSVWriter::appendChar(char c)                       { buffer += c; }
+
+inline void CSVWriter::appendQuoted(const string& field) {
+	buffer += '"';
+	const char* p = field.data();
+	const char* end = p + field.size();
+	while (p < end) {
+		// Copy everything up to the next quote in one go, then double that quote
+		const char* q = (const char*)memchr(p, '"', (size_t)(end - p));
+		if (q == nullptr) { buffer.append(p, (size_t)(end - p)); break; }
+		buffer.append(p, (size_t)(q - p + 1));
+		buffer += '"';
+		p = q + 1;
+	}
+	buffer += '"';
+}
+
+inline void CSVWriter::appendInt(int value) {
+	char digits[12];
+	int n = 0;
+	unsigned int magnitude = (value < 0) ? 0u - (unsigned int)value : (unsigned int)value;
+	do {
+		digits[n++] = (char)('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude != 0);
+	if (value < 0) buffer += '-';
+	while (n > 0) buffer += digits[--n];
+}
+
+inline void CSVWriter::endRow() {
+	buffer += '\n';
+	if (sink != nullptr && buffer.size() >= blockSize) flush();
+}
+
+// Large pre-formatted blocks skip the copy into our buffer when we have a sink
+inline void CSVWriter::appendBlock(const string& block) {
+	if (sink == nullptr) { buffer.append(block); return; }
+	flush();
+	sink->write(block.data(), (streamsize)block.size());
+}
+
+inline void CSVWriter::flush() {
+	if (sink == nullptr || buffer.size() == 0) return;
+	sink->write(buffer.data(), (streamsize)buffer.size());
+	buffer.clear(); // keeps the capacity for the next block
+}
+
+inline const string& CSVWriter::pending() const { return buffer; }
+
+inline void CSVWriter::takePending(string& out) {
+	out.clear();
+	out.swap(buffer);
+}
+
+// -----------------------------------------------------------------------------
+// End guard: keep headers clean and avoid accidental extra code below.
+// -----------------------------------------------------------------------------
+#endif
@@ -0,0 +1,173 @@
+#ifndef _DUPLICATEINDEX_H
+#define _DUPLICATEINDEX_H
+
+// -----------------------------------------------------------------------------
+// Library Catalog Project — DuplicateIndex (catalog-wide duplicate lookup).
+// Book::operator== says two books are the same if their ISBNs match (when both
+// have one), otherwise if (title, author, year) match. Scanning the whole tree
+// for that on every import row is O(n^2), so the Tree keeps this hash index in
+// sync instead and every duplicate check becomes an O(1) average lookup.
+// I use inline functions so that the function definitions inside the header file don’t cause linker errors when the header is included in multiple source files
+// Source: https://stackoverflow.com/questions/5057021/why-do-inline-functions-have-to-be-defined-in-a-header-file
+// -----------------------------------------------------------------------------
+
+#include <string>         // keys are plain strings
+#include <unordered_map>  // hash tables from key -> number of books sharing it
+#include <stdint.h>       // packed ISBN keys
+#include "book.hpp"       // Book model (fields + equality rule we mirror)
+
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// DuplicateIndex: multiset counts that answer "is there a book == b?" exactly.
+//
+// For a candidate with an ISBN, an existing book matches if it has the same
+// ISBN, or if it has no ISBN and the same (title, author, year). ISBNs that
+// normalize (Book::getISBNKey) are counted by their packed 64-bit key, so the
+// common check is an integer hash lookup; only odd ISBN text is keyed by string.
+// For a candidate without an ISBN, any book with the same triple matches.
+// Books with and without ISBN land in disjoint tables, so counts never overlap.
+// -----------------------------------------------------------------------------
+class DuplicateIndex
+{
+	private:
+		// Books whose ISBN normalizes, keyed by the packed ISBN
+		unordered_map<uint64_t, int> isbnKeyCounts;
+
+		// Books with some other non-empty ISBN text, keyed by that text
+		unordered_map<string, int> isbnCounts;
+
+		// Every book, keyed by (title, author, year)
+		unordered_map<string, int> tripleCounts;
+
+		// Only the books without an ISBN, keyed by (title, author, year)
+		unordered_map<string, int> tripleNoISBNCounts;
+
+		// Reused key buffer so lookups don't allocate (index is single-threaded)
+		mutable string keyScratch;
+
+		// Length-prefixed key so no title/author text can collide with another
+		static void tripleKey(const Book& b, string& key);
+
+		// Add delta to a count and drop the entry once it reaches zero
+		template <typename K>
+		static void bump(unordered_map<K, int>& table, const K& key, int delta);
+
+		// Look up a count (0 if missing)
+		template <typename K>
+		static int countOf(const unordered_map<K, int>& table, const K& key);
+
+		// Add delta to the ISBN table this book belongs in (keyed or raw text)
+		void bumpISBN(const Book& b, int delta);
+
+		// Number of indexed books that compare equal to b
+		int matchCount(const Book& b) const;
+
+	public:
+		// Register / unregister a book (call with the values it is stored under)
+		void add(const Book& b);
+		void remove(const Book& b);
+
+		// Forget everything (used when the whole catalog is replaced)
+		void clear();
+
+		// True if some indexed book == b
+		bool contains(const Book& b) const;
+
+		// Same as contains(), but the indexed book 'skip' does not count
+		bool containsExcept(const Book& b, const Book* skip) const;
+};
+
+// ============================================================================
+// DuplicateIndex methods
+// ============================================================================
+
+// "<len>:title<authorId>:<year>" — unambiguous even if titles contain separators;
+// the interned author id stands in for the author text (equal ids == equal text)
+inline void DuplicateIndex::tripleKey(const Book& b, string& key) {
+	const string& title = b.getTitle();
+	key.clear(); // keep the buffer's capacity between calls
+	key += to_string(title.size());
+	key += ':';
+	key += title;
+	key += to_string(b.getAuthorId());
+	key += ':';
+	key += to_string(b.getYear());
+}
+
+// Keep the tables small by erasing keys that no book uses anymore
+template <typename K>
+inline void DuplicateIndex::bump(unordered_map<K, int>& table, const K& key, int delta) {
+	int& count = table[key];
+	count += delta;
+	if (count <= 0) table.erase(key);
+}
+
+template <typename K>
+inline int DuplicateIndex::countOf(const unordered_map<K, int>& table, const K& key) {
+	typename unordered_map<K, int>::const_iterator it = table.find(key);
+	return (it == table.end()) ? 0 : it->second;
+}
+
+inline void DuplicateIndex::bumpISBN(const Book& b, int delta) {
+	uint64_t key = b.getISBNKey();
+	if (key != 0) bump(isbnKeyCounts, key, delta);
+	else          bump(isbnCounts, b.getISBN(), delta);
+}
+
+// Mirrors Book::operator== (see class comment for the two cases)
+inline int DuplicateIndex::matchCount(const Book& b) const {
+	const string& isbn = b.getISBN();
+	if (isbn == "") {
+		tripleKey(b, keyScratch);
+		return countOf(tripleCounts, keyScratch);
+	}
+
+	uint64_t key = b.getISBNKey();
+	int count = (key != 0) ? countOf(isbnKeyCounts, key) : countOf(isbnCounts, isbn);
+
+	// Catalogs rarely mix in ISBN-less books, so usually no triple key is built at all
+	if (!tripleNoISBNCounts.empty()) {
+		tripleKey(b, keyScratch);
+		count += countOf(tripleNoISBNCounts, keyScratch);
+	}
+	return count;
+}
+
+inline void DuplicateIndex::add(const Book& b) {
+	tripleKey(b, keyScratch);
+	bump(tripleCounts, keyScratch, 1);
+	if (b.getISBN() == "") bump(tripleNoISBNCounts, keyScratch, 1);
+	else                   bumpISBN(b, 1);
+}
+
+inline void DuplicateIndex::remove(const Book& b) {
+	tripleKey(b, keyScratch);
+	bump(tripleCounts, keyScratch, -1);
+	if (b.getISBN() == "") bump(tripleNoISBNCounts, keyScratch, -1);
+	else                   bumpISBN(b, -1);
+}
+
+inline void DuplicateIndex::clear() {
+	isbnKeyCounts.clear();
+	isbnCounts.clear();
+	tripleCounts.clear();
+	tripleNoISBNCounts.clear();
+}
+
+inline bool DuplicateIndex::contains(const Book& b) const {
+	return matchCount(b) > 0;
+}
+
+// 'skip' is indexed under its current values, so it contributes one match
+// exactly when it is itself equal to b
+inline bool DuplicateIndex::containsExcept(const Book& b, const Book* skip) const {
+	int count = matchCount(b);
+	if (skip != nullptr && *skip == b) count--;
+	return count > 0;
+}
+
+// -----------------------------------------------------------------------------
+// End guard: keep headers clean and avoid accidental extra code below.
+// -----------------------------------------------------------------------------
+#endif
@@ -0,0 +1,85 @@
+#ifndef _ISBNINDEX_H
+#define _ISBNINDEX_H
+
+// -----------------------------------------------------------------------------
+// Library Catalog Project — IsbnIndex (ISBN -> book, behind findISBN).
+// Books are keyed by their packed ISBN (Book::getISBNKey), so a lookup for
+// "0-14-044913-X", "014044913X" or "9780140449136" lands on the same book.
+// ISBN text that does not normalize is kept in a second table by raw text.
+// The duplicate rule (Book::operator==) never lets two books share an ISBN,
+// so each key maps to exactly one book.
+// I use inline functions so that the function definitions inside the header file don’t cause linker errors when the header is included in multiple source files
+// Source: https://stackoverflow.com/questions/5057021/why-do-inline-functions-have-to-be-defined-in-a-header-file
+// -----------------------------------------------------------------------------
+
+#include <string>         // raw ISBN text
+#include <unordered_map>  // key -> book
+#include <stdint.h>       // packed ISBN keys
+#include "book.hpp"       // Book model + isbnToKey
+
+using namespace std;
+
+class IsbnIndex
+{
+	private:
+		// Packed ISBN -> book
+		unordered_map<uint64_t, Book*> byKey;
+
+		// Non-empty ISBN text that does not normalize -> book
+		unordered_map<string, Book*> byText;
+
+	public:
+		// Register / unregister a book under its current ISBN (books without one are skipped)
+		void add(Book* book);
+		void remove(Book* book);
+
+		// Forget everything
+		void clear();
+
+		// The book with this ISBN (any spelling that normalizes the same), or nullptr
+		Book* find(const string& isbn) const;
+};
+
+// ============================================================================
+// IsbnIndex methods
+// ============================================================================
+
+inline void IsbnIndex::add(Book* book) {
+	if (book->getISBN() == "") return;
+	uint64_t key = book->getISBNKey();
+	if (key != 0) byKey[key] = book;
+	else          byText[book->getISBN()] = book;
+}
+
+// Only erase the entry if it still points at this book
+inline void IsbnIndex::remove(Book* book) {
+	if (book->getISBN() == "") return;
+	uint64_t key = book->getISBNKey();
+	if (key != 0) {
+		unordered_map<uint64_t, Book*>::iterator it = byKey.find(key);
+		if (it != byKey.end() && it->second == book) byKey.erase(it);
+	} else {
+		unordered_map<string, Book*>::iterator it = byText.find(book->getISBN());
+		if (it != byText.end() && it->second == book) byText.erase(it);
+	}
+}
+
+inline void IsbnIndex::clear() {
+	byKey.clear();
+	byText.clear();
+}
+
+inline Book* IsbnIndex::find(const string& isbn) const {
+	uint64_t key = isbnToKey(isbn);
+	if (key != 0) {
+		unordered_map<uint64_t, Book*>::const_iterator it = byKey.find(key);
+		return (it == byKey.end()) ? nullptr : it->second;
+	}
+	unordered_map<string, Book*>::const_iterator it = byText.find(isbn);
+	return (it == byText.end()) ? nullptr : it->second;
+}
+
+// -----------------------------------------------------------------------------
+// End guard: keep headers clean and avoid accidental extra code below.
+// -----------------------------------------------------------------------------
+#endif
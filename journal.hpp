@@ -0,0 +1,391 @@
+#ifndef _JOURNAL_H
+#define _JOURNAL_H
+
+// -----------------------------------------------------------------------------
+// Library Catalog Project — Write-ahead journal for catalog mutations.
+// Instead of rewriting the whole catalog after every edit, each successful
+// mutation is appended here as a small binary record. On startup the journal
+// is replayed on top of the last snapshot, so one edit costs O(1) I/O.
+//
+// File layout:
+//   "LCMSJRNL"                                   8-byte magic
+//   record*   = u32 bodyLength, u32 checksum, body
+//   body      = u8 op, u64 seq, op-specific fields
+//   fields    = strings as u32 length + bytes, years as i32
+//
+// Records are buffered and written + fsync'd together on commit() (group
+// commit), so a 2M-row import costs a handful of large writes and one fsync.
+// A crash can leave a torn record at the end; the reader stops at the first
+// record whose length or checksum does not add up and the tail is cut off.
+//
+// A checkpoint retires the current file by renaming it to "<journal>.old" and
+// starting a fresh one; replay reads the retired segment first if it is still
+// there (i.e. the checkpoint that would have replaced it never finished).
+// I use inline functions so that the function definitions inside the header file don’t cause linker errors when the header is included in multiple source files
+// Source: https://stackoverflow.com/questions/5057021/why-do-inline-functions-have-to-be-defined-in-a-header-file
+// -----------------------------------------------------------------------------
+
+#include <string>     // record fields + pending buffer
+#include <cstdio>     // FILE* for appending
+#include <cstring>    // memcpy when decoding
+#include <stdint.h>   // fixed-width fields
+#include "book.hpp"   // records carry whole books
+#include "csv.hpp"    // MappedFile for reading the journal back (and LCMS_HAVE_MMAP)
+
+using namespace std;
+
+static const char JOURNAL_MAGIC[8] = { 'L', 'C', 'M', 'S', 'J', 'R', 'N', 'L' };
+
+// -----------------------------------------------------------------------------
+// JournalOp: one value per mutating catalog command.
+// -----------------------------------------------------------------------------
+enum JournalOp
+{
+	JOURNAL_ADD_BOOK        = 1, // path + book
+	JOURNAL_EDIT_BOOK       = 2, // path + old book + new book
+	JOURNAL_REMOVE_BOOK     = 3, // path + book
+	JOURNAL_ADD_CATEGORY    = 4, // path
+	JOURNAL_EDIT_CATEGORY   = 5, // path + new name
+	JOURNAL_REMOVE_CATEGORY = 6  // path
+};
+
+// -----------------------------------------------------------------------------
+// JournalRecord: decoded form of one record. Only the fields used by 'op'
+// are meaningful; books are identified by their node path + exact fields.
+// -----------------------------------------------------------------------------
+struct JournalRecord
+{
+	int      op;
+	uint64_t seq;
+	string   path;
+	Book     book;      // the book as stored (add/remove) or before the edit
+	Book     edited;    // EDIT_BOOK: values after the edit
+	string   name;      // EDIT_CATEGORY: new segment name
+};
+
+// -----------------------------------------------------------------------------
+// Journal: append side. Owns the open file and the group-commit buffer.
+// -----------------------------------------------------------------------------
+class Journal
+{
+	private:
+		// Open journal file (nullptr until open() succeeds) and its name
+		FILE* file;
+		string path;
+
+		// Encoded records that have not been written yet
+		string pending;
+
+		// Sequence number given to the next record
+		uint64_t nextSeq;
+
+		// Write 'pending' to the file (no fsync)
+		bool writePending();
+
+	public:
+		Journal();
+		~Journal();
+
+		Journal(const Journal&) = delete;
+		Journal& operator=(const Journal&) = delete;
+
+		// Open for appending; creates the file (with magic) if missing.
+		// 'validBytes' is how much of an existing file the reader accepted;
+		// anything after it (a torn record) is cut off first.
+		bool open(const string& path, size_t validBytes, uint64_t nextSeq);
+
+		// Queue one record (assigns its sequence number)
+		void append(JournalRecord& record);
+
+		// Commit, rename the file to 'retiredPath' and continue in a fresh file
+		// (sequence numbers keep counting up across the switch)
+		bool rotate(const string& retiredPath);
+
+		// Write everything queued and fsync once (group commit)
+		bool commit();
+
+		// Sequence number of the last record appended (0 if none yet)
+		uint64_t lastSeq() const;
+
+		bool isOpen() const;
+		const string& getPath() const;
+};
+
+// Name of the segment a checkpoint retires (replayed before the live journal)
+inline string journalRetiredPath(const string& journalPath) { return journalPath + ".old"; }
+
+// -----------------------------------------------------------------------------
+// JournalReader: maps a journal and hands back its records in order.
+// -----------------------------------------------------------------------------
+class JournalReader
+{
+	private:
+		MappedFile file;
+		size_t offset;
+		bool corrupt;
+
+	public:
+		JournalReader();
+
+		// False if the file exists but is not a journal; a missing file is an empty journal
+		bool open(const string& path, bool& exists);
+
+		// Next intact record; false at the end (or at the first torn record)
+		bool next(JournalRecord& record);
+
+		// Bytes up to the end of the last intact record
+		size_t validBytes() const;
+
+		// True if reading stopped early because of a damaged record
+		bool sawDamage() const;
+};
+
+// ============================================================================
+// Encoding helpers
+// ============================================================================
+
+// FNV-1a: cheap, and plenty to spot a torn or garbled record
+inline uint32_t _journal_checksum(const char* data, size_t size) {
+	uint32_t h = 2166136261u;
+	for (size_t i = 0; i < size; ++i) {
+		h ^= (unsigned char)data[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+template <typename T>
+inline void _journal_put(string& out, const T& value) {
+	out.append((const char*)&value, sizeof(T));
+}
+
+inline void _journal_putString(string& out, const string& s) {
+	_journal_put(out, (uint32_t)s.size());
+	out += s;
+}
+
+inline void _journal_putBook(string& out, const Book& b) {
+	_journal_putString(out, b.getTitle());
+	_journal_putString(out, b.getAuthor());
+	_journal_putString(out, b.getISBN());
+	_journal_put(out, (int32_t)b.getYear());
+}
+
+// Bounds-checked cursor over one record body
+struct _JournalCursor
+{
+	const char* p;
+	const char* end;
+
+	template <typename T>
+	bool get(T& value) {
+		if ((size_t)(end - p) < sizeof(T)) return false;
+		memcpy(&value, p, sizeof(T));
+		p += sizeof(T);
+		return true;
+	}
+
+	bool getString(string& s) {
+		uint32_t len;
+		if (!get(len) || (size_t)(end - p) < len) return false;
+		s.assign(p, len);
+		p += len;
+		return true;
+	}
+
+	bool getBook(Book& b) {
+		string title, author, isbn;
+		int32_t year;
+		if (!getString(title) || !getString(author) || !getString(isbn) || !get(year)) return false;
+		b = Book(title, author, isbn, year);
+		return true;
+	}
+};
+
+// ============================================================================
+// Journal methods
+// ============================================================================
+
+inline Journal::Journal() {
+	file = nullptr;
+	nextSeq = 1;
+}
+
+inline Journal::~Journal() {
+	if (file != nullptr) {
+		commit();
+		fclose(file);
+		file = nullptr;
+	}
+}
+
+inline bool Journal::open(const string& path, size_t validBytes, uint64_t nextSeq) {
+	this->path = path;
+	this->nextSeq = nextSeq;
+
+	// Cut a torn tail before appending after it
+	if (validBytes > 0) {
+#ifdef LCMS_HAVE_MMAP
+		if (truncate(path.c_str(), (off_t)validBytes) != 0) return false;
+#else
+		MappedFile old;
+		if (!old.open(path)) return false;
+		string keep(old.data(), validBytes < old.size() ? validBytes : old.size());
+		old.close();
+		FILE* rewrite = fopen(path.c_str(), "wb");
+		if (!rewrite) return false;
+		fwrite(keep.data(), 1, keep.size(), rewrite);
+		fclose(rewrite);
+#endif
+	}
+
+	file = fopen(path.c_str(), validBytes > 0 ? "ab" : "wb");
+	if (!file) return false;
+	if (validBytes == 0) {
+		pending.append(JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+		if (!commit()) return false;
+		if (!fsyncParentDir(path)) return false; // a new file is only durable once its directory entry is
+	}
+	return true;
+}
+
+inline void Journal::append(JournalRecord& record) {
+	record.seq = nextSeq++;
+
+	// Encode the body first so its length and checksum can lead the record
+	string body;
+	_journal_put(body, (uint8_t)record.op);
+	_journal_put(body, record.seq);
+	_journal_putString(body, record.path);
+	switch (record.op) {
+		case JOURNAL_ADD_BOOK:
+		case JOURNAL_REMOVE_BOOK:
+			_journal_putBook(body, record.book);
+			break;
+		case JOURNAL_EDIT_BOOK:
+			_journal_putBook(body, record.book);
+			_journal_putBook(body, record.edited);
+			break;
+		case JOURNAL_EDIT_CATEGORY:
+			_journal_putString(body, record.name);
+			break;
+		default:
+			break; // ADD/REMOVE_CATEGORY only need the path
+	}
+
+	_journal_put(pending, (uint32_t)body.size());
+	_journal_put(pending, _journal_checksum(body.data(), body.size()));
+	pending += body;
+
+	// Keep memory bounded during huge imports; durability still waits for commit()
+	if (pending.size() >= (1 << 20)) writePending();
+}
+
+inline bool Journal::writePending() {
+	if (file == nullptr) return false;
+	if (pending.size() == 0) return true;
+	bool ok = fwrite(pending.data(), 1, pending.size(), file) == pending.size();
+	pending.clear();
+	return ok;
+}
+
+inline bool Journal::commit() {
+	if (file == nullptr) return false;
+	bool ok = writePending();
+	ok = (fflush(file) == 0) && ok;
+#ifdef LCMS_HAVE_MMAP
+	ok = ok && fsync(fileno(file)) == 0;
+#endif
+	return ok;
+}
+
+inline bool Journal::rotate(const string& retiredPath) {
+	if (file == nullptr || !commit()) return false;
+	fclose(file);
+	file = nullptr;
+	if (rename(path.c_str(), retiredPath.c_str()) != 0) {
+		file = fopen(path.c_str(), "ab"); // keep journaling into the old file
+		return false;
+	}
+	// open() syncs the directory after creating the fresh file, which also makes
+	// the rename durable (the retired segment lives next to the journal)
+	return open(path, 0, nextSeq);
+}
+
+inline uint64_t Journal::lastSeq() const { return nextSeq - 1; }
+inline bool Journal::isOpen() const { return file != nullptr; }
+inline const string& Journal::getPath() const { return path; }
+
+// ============================================================================
+// JournalReader methods
+// ============================================================================
+
+inline JournalReader::JournalReader() {
+	offset = 0;
+	corrupt = false;
+}
+
+inline bool JournalReader::open(const string& path, bool& exists) {
+	exists = false;
+	FILE* probe = fopen(path.c_str(), "rb");
+	if (!probe) return true; // no journal yet: nothing to replay
+	fclose(probe);
+
+	exists = true;
+	if (!file.open(path)) return false;
+	if (file.size() == 0) { exists = false; return true; } // treat like a fresh file
+	if (file.size() < sizeof(JOURNAL_MAGIC) || memcmp(file.data(), JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0) return false;
+	offset = sizeof(JOURNAL_MAGIC);
+	return true;
+}
+
+inline bool JournalReader::next(JournalRecord& record) {
+	if (corrupt || file.data() == nullptr || offset >= file.size()) return false;
+
+	const char* at = file.data() + offset;
+	size_t left = file.size() - offset;
+	uint32_t length, checksum;
+	if (left < 8) { corrupt = true; return false; }
+	memcpy(&length, at, 4);
+	memcpy(&checksum, at + 4, 4);
+	if (left - 8 < length || _journal_checksum(at + 8, length) != checksum) { corrupt = true; return false; }
+
+	_JournalCursor c;
+	c.p = at + 8;
+	c.end = c.p + length;
+
+	uint8_t op = 0;
+	bool ok = c.get(op) && c.get(record.seq) && c.getString(record.path);
+	record.op = op;
+	if (ok) {
+		switch (op) {
+			case JOURNAL_ADD_BOOK:
+			case JOURNAL_REMOVE_BOOK:
+				ok = c.getBook(record.book);
+				break;
+			case JOURNAL_EDIT_BOOK:
+				ok = c.getBook(record.book) && c.getBook(record.edited);
+				break;
+			case JOURNAL_EDIT_CATEGORY:
+				ok = c.getString(record.name);
+				break;
+			case JOURNAL_ADD_CATEGORY:
+			case JOURNAL_REMOVE_CATEGORY:
+				break;
+			default:
+				ok = false;
+		}
+	}
+	if (!ok || c.p != c.end) { corrupt = true; return false; }
+
+	offset += 8 + length;
+	return true;
+}
+
+inline size_t JournalReader::validBytes() const { return offset; }
+inline bool JournalReader::sawDamage() const { return corrupt; }
+
+// -----------------------------------------------------------------------------
+// End guard: keep headers clean and avoid accidental extra code below.
+// -----------------------------------------------------------------------------
+#endif
@@ -13,9 +13,19 @@
 
 #include <iostream>   // For CLI-style I/O (cout/cin)
 #include <fstream>    // For file import/export (ifstream/ofstream)
+#include <thread>     // Worker threads for "import/export --threads N"
+#include <mutex>      // Hand-off of finished export buffers
+#include <condition_variable>
+#include <atomic>     // Work counter shared by export workers
+#include <system_error> // A worker thread the OS refused to start
+#include <chrono>     // Age of the last checkpoint
 
 #include "tree.hpp"   // Category tree + book storage structure
 #include "book.hpp"   // Book model (fields, printing, CSV helpers)
+#include "csv.hpp"    // Memory-mapped CSV input + zero-copy row tokenizer
+#include "snapshot.hpp" // Binary catalog images for fast startup
+#include "journal.hpp"  // Write-ahead journal of catalog mutations
+#include "checkpoint.hpp" // Background snapshot writer that shortens the journal
 
 // -----------------------------------------------------------------------------
 // LCMS = thin facade over the Tree with CLI-ish routines for the assignment.
@@ -28,24 +38,71 @@ class LCMS
 		// libTree owns the whole catalog hierarchy (root + subcategories + books).
 	    Tree* libTree;
 
+	    // Book removal mode applied to every tree we hold (--unordered-books)
+	    bool unorderedBooks;
+
+	    // Write-ahead journal (nullptr unless started with --journal) and the
+	    // snapshot file it continues from.
+	    Journal* journal;
+	    string baseSnapshot;
+
+	    // Queue one mutation record / make the queued ones durable (no-ops without a journal)
+	    void journalAppend(JournalRecord& record);
+	    void journalCommit();
+
+	    // Re-apply one journaled mutation on startup; false if it no longer fits the catalog
+	    bool replayRecord(const JournalRecord& record);
+
+	    // Background checkpoints: writer thread, journal position and time of the last one
+	    Checkpointer checkpointer;
+	    uint64_t checkpointSeq;
+	    chrono::steady_clock::time_point lastCheckpoint;
+
+	    // Retire the journal and have the Checkpointer snapshot the tree in the background
+	    bool startCheckpoint();
+
 	public:
 	    // ctor: Build LCMS around a named root (e.g., "Library").
 	    LCMS(string name);
 
-	    // dtor: Tear down the entire tree. Nodes delete their children and books.
+	    // dtor: Tear down the entire tree. The Tree releases every node and book.
 	    ~LCMS();
 
+	    // openCatalog: Startup persistence. Loads 'snapshotFile' (if it exists), replays
+	    // 'journalFile' on top of it, and from then on journals every mutation.
+	    // An empty journalFile just loads the snapshot. False if either file is unusable.
+	    bool openCatalog(string snapshotFile, string journalFile);
+
+	    // setUnorderedBooks: Opt in to O(1) book removal (see Tree::setUnorderedBooks).
+	    // Call before openCatalog so snapshot loads and journal replay use it too.
+	    void setUnorderedBooks(bool on);
+
+	    // checkpoint: Write a new base snapshot in the background and drop the journal
+	    // records it covers. maybeCheckpoint does the same when enough has changed;
+	    // main calls it between commands and import calls it between rows.
+	    void checkpoint();
+	    void maybeCheckpoint();
+
 	    // import: Read CSV rows and add books to the right categories (creates paths).
+	    // Accepts "--threads N <file>" to parse on N worker threads.
 	    // Returns 0 on success (file opened), prints how many records got added.
 	    int  import(string path);
 
 	    // exportData: Dump all records back to a CSV with a header row for grading.
+	    // Accepts "--threads N <file>" to format top-level subtrees in parallel.
 	    void exportData(string path);
 
+	    // saveSnapshot / loadSnapshot: Binary image of the whole catalog.
+	    // Loading replaces the current catalog and skips all CSV parsing.
+	    void saveSnapshot(string path);
+	    void loadSnapshot(string path);
+
 	    // find: Keyword search across categories and books; prints tidy sections.
 	    void find(string keyword);
 
         // findByAuthor: Print all books whose author field contains the given text.
+        // "--exact name" asks for that exact author, "--prefix text" for authors
+        // starting with text (both case/spacing-insensitive).
         // This is my “extra feature” to make searching by author faster for users.
         void findByAuthor(string author) const;
 
@@ -57,6 +114,12 @@ class LCMS
 
 	  	// findBook: Single-title lookup with a nice bordered detail block.
 	    void findBook(string bookTitle);
+
+	    // findISBN: Look a book up by ISBN (hyphens and ISBN-10/13 spelling ignored).
+	    void findISBN(string isbn);
+
+	    // findYear: Books published in "<from>-<to>" (or one year), optionally under a category.
+	    void findYear(string args);
  		
  		// addBook: Interactive prompts, validation, duplicate guard, then insert.
 	    void addBook();
@@ -105,54 +168,55 @@ static string _lcms_trim(const string& s) {
 }
 
 // ---------------------------------------------------------------
-// _lcms_normalizePath: Collapse duplicate '/' and trim each segment.
+// _lcms_normalizePathInto: Collapse duplicate '/' and trim each segment.
 // Example: "  CS//  Algo  / " -> "CS/Algo". This avoids weird paths.
+// Works on a raw span and writes into 'out' so import can reuse one buffer.
 // ---------------------------------------------------------------
-static string _lcms_normalizePath(const string& path) {
-    string out = "", seg = "";
-    bool lastWasSlash = false;
-
-    for (int i = 0; i < (int)path.size(); ++i) {
-        char c = path[i];
-        if (c == '/') {
-            if (!lastWasSlash) {
-                string t = _lcms_trim(seg);
-                if (t.size() > 0) {
-                    if (out.size() > 0) out += "/";
-                    out += t;
-                }
-                seg = "";
-                lastWasSlash = true;
-            }
-        } else {
-            seg += c;
-            lastWasSlash = false;
-        }
-    }
-    // Flush the final segment (if any).
-    string t = _lcms_trim(seg);
-    if (t.size() > 0) {
-        if (out.size() > 0) out += "/";
-        out += t;
+static void _lcms_normalizePathInto(const char* path, int n, string& out) {
+    out.clear();
+    int i = 0;
+    while (i < n) {
+        // Find the next segment [segStart, segEnd) between slashes.
+        int segStart = i;
+        while (i < n && path[i] != '/') i++;
+        int segEnd = i;
+        i++; // step over the '/'
+
+        // Trim spaces/tabs and skip empty segments (from "//" or blanks).
+        while (segStart < segEnd && (path[segStart] == ' ' || path[segStart] == '\t')) segStart++;
+        while (segEnd > segStart && (path[segEnd - 1] == ' ' || path[segEnd - 1] == '\t')) segEnd--;
+        if (segEnd == segStart) continue;
+
+        if (out.size() > 0) out += '/';
+        out.append(path + segStart, segEnd - segStart);
     }
+}
+
+// String convenience wrapper used by the interactive commands.
+static string _lcms_normalizePath(const string& path) {
+    string out;
+    _lcms_normalizePathInto(path.data(), (int)path.size(), out);
     return out;
 }
 
 // --------------------------------------------------------------------
-// _lcms_parseYear: Allow optional leading '-' for ancient dates.
+// _lcms_parseYearSpan: Allow optional leading '-' for ancient dates.
 // Returns true only if the rest are digits. Keeps input handling robust.
 // --------------------------------------------------------------------
-static bool _lcms_parseYear(const string& s, int& outYear) {
-    string t = _lcms_trim(s);
-    if (t.size() == 0) return false;
+static bool _lcms_parseYearSpan(const char* s, int n, int& outYear) {
+    // Trim spaces/tabs without copying.
+    int b = 0, e = n;
+    while (b < e && (s[b] == ' ' || s[b] == '\t')) b++;
+    while (e > b && (s[e - 1] == ' ' || s[e - 1] == '\t')) e--;
+    if (b == e) return false;
 
-    int i = 0, sign = 1;
-    if (t[0] == '-') { sign = -1; i = 1; }
-    if (i >= (int)t.size()) return false;
+    int i = b, sign = 1;
+    if (s[i] == '-') { sign = -1; i++; }
+    if (i >= e) return false;
 
     long val = 0;
-    for (; i < (int)t.size(); ++i) {
-        char c = t[i];
+    for (; i < e; ++i) {
+        char c = s[i];
         if (c < '0' || c > '9') return false;
         val = val * 10 + (c - '0');
     }
@@ -160,41 +224,151 @@ static bool _lcms_parseYear(const string& s, int& outYear) {
     return true;
 }
 
-// ---------------------------------------------------------------------------------
-// _lcms_parseCSVLine: Manual CSV split that understands quotes and "" escapes (to parse the CSV line into fields)
-// Expected 5 fields total: Title, Author, ISBN, Publication Year, Category.
-// I use this to avoid pulling in a CSV library for a small assignment.
-// ---------------------------------------------------------------------------------
-static bool _lcms_parseCSVLine(const string& line, MyVector<string>& fieldsOut) {
-    fieldsOut.clear();
-    string cur = "";
-    bool inQuotes = false;
-
-    for (int i = 0; i < (int)line.size(); ++i) {
-        char c = line[i];
-        if (inQuotes) {
-            if (c == '"') {
-                if (i + 1 < (int)line.size() && line[i + 1] == '"') {
-                    cur += '"'; i++; // add an escaped quote and skip the second one
-                } else {
-                    inQuotes = false; // end quote
-                }
-            } else {
-                cur += c; // regular char inside quotes
-            }
-        } else {
-            if (c == ',') {
-                fieldsOut.push_back(_lcms_trim(cur));
-                cur = "";
-            } else if (c == '"') {
-                inQuotes = true;
-            } else {
-                cur += c;
-            }
-        }
+// String convenience wrapper used by the interactive prompts.
+static bool _lcms_parseYear(const string& s, int& outYear) {
+    return _lcms_parseYearSpan(s.data(), (int)s.size(), outYear);
+}
+
+// -----------------------------------------------------------------------------
+// _lcms_ImportRow: One validated CSV row, ready to become a Book.
+// The strings are reused row after row, so they keep their capacity.
+// -----------------------------------------------------------------------------
+struct _lcms_ImportRow {
+    string title;
+    string author;
+    string isbn;
+    string path;   // already normalized
+    int year;
+};
+
+// Below this size a threaded import is slower than just doing it serially.
+static const size_t _LCMS_MIN_PARALLEL_BYTES = 1 << 20;
+
+// A checkpoint starts once this many records were journaled since the last one,
+// or once any were and the last one is this old.
+static const uint64_t _LCMS_CHECKPOINT_RECORDS = 50000;
+static const int      _LCMS_CHECKPOINT_SECONDS = 60;
+
+// An import checks for a due checkpoint after this many added rows.
+static const int _LCMS_CHECKPOINT_CHECK_ROWS = 4096;
+
+// -----------------------------------------------------------------------------
+// _lcms_parseImportRow: Consume one line starting at 'p' (advancing p past it)
+// and fill 'row' if the line is a valid record. Safe to call from worker
+// threads: it only reads the buffer and writes to its own arguments.
+// -----------------------------------------------------------------------------
+static bool _lcms_parseImportRow(const char*& p, const char* end, bool& firstLine, _lcms_ImportRow& row, string& scratch) {
+    // Tokenize one line into field views (the scanner also finds the newline).
+    const char* line = p;
+    CSVField fields[5];
+    int fieldCount = csvScanRow(line, end, fields, 5, &p);
+
+    // I treat the first "Title,..." as a header to skip.
+    if (firstLine) {
+        firstLine = false;
+        if (end - line >= 6 && memcmp(line, "Title,", 6) == 0) return false;
+    }
+
+    // Expect exactly 5 fields.
+    if (fieldCount != 5) return false;
+
+    // Reject malformed years straight from the view when possible.
+    if (fields[3].needsDecode) {
+        csvFieldAssign(fields[3], scratch);
+        if (!_lcms_parseYear(scratch, row.year)) return false;
+    } else if (!_lcms_parseYearSpan(fields[3].data, fields[3].size, row.year)) {
+        return false;
+    }
+
+    // Normalize category path so “/CS//Algo/ ” becomes “CS/Algo”.
+    if (fields[4].needsDecode) {
+        csvFieldAssign(fields[4], scratch);
+        _lcms_normalizePathInto(scratch.data(), (int)scratch.size(), row.path);
+    } else {
+        _lcms_normalizePathInto(fields[4].data, fields[4].size, row.path);
+    }
+    if (row.path.size() == 0) return false; // empty category isn’t allowed
+
+    csvFieldAssign(fields[0], row.title);
+    csvFieldAssign(fields[1], row.author);
+    csvFieldAssign(fields[2], row.isbn);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// _lcms_mergeImportRow: Add one parsed row to the tree unless it is a duplicate.
+// 'candidate' is a reused scratch Book; a heap Book is only made for real adds.
+// Always runs on the calling thread, in file order.
+// -----------------------------------------------------------------------------
+static bool _lcms_mergeImportRow(Tree* tree, const _lcms_ImportRow& row, Book& candidate) {
+    // Avoid duplicates anywhere in the library (hash lookup, not a tree walk).
+    candidate.setTitle(row.title);
+    candidate.setAuthor(row.author);
+    candidate.setISBN(row.isbn);
+    candidate.setYear(row.year);
+    if (tree->containsBook(candidate)) return false;
+
+    // Ensure the category exists (mkdir -p style).
+    Node* node = tree->createNode(row.path);
+    if (!node) return false; // extremely unlikely, but safe to guard
+
+    // Finally add the book (the Tree stores its own pooled copy).
+    return tree->addBook(node, candidate) != nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// _lcms_parseThreadsOption: Strip a leading "--threads N" from a command argument.
+// Leaves 'args' holding the rest (the file name). False if N is malformed.
+// N is capped at the number of hardware threads (at least 1).
+// -----------------------------------------------------------------------------
+static bool _lcms_parseThreadsOption(string& args, int& threads) {
+    string rest = _lcms_trim(args);
+    if (rest.compare(0, 9, "--threads") != 0) { args = rest; return true; }
+
+    rest = _lcms_trim(rest.substr(9));
+    size_t digits = 0;
+    while (digits < rest.size() && rest[digits] >= '0' && rest[digits] <= '9') digits++;
+    if (digits == 0 || digits > 4) return false;
+
+    threads = atoi(rest.substr(0, digits).c_str());
+    if (threads < 1) return false;
+
+    // Every worker is a real thread: more of them than cores only costs start-up
+    // time (and asking for thousands can exhaust the process's thread limit)
+    unsigned cores = thread::hardware_concurrency();
+    int limit = cores > 0 ? (int)cores : 1;
+    if (threads > limit) threads = limit;
+
+    args = _lcms_trim(rest.substr(digits));
+    return args.size() > 0;
+}
+
+// -----------------------------------------------------------------------------
+// _lcms_takeFlag: Strip a leading flag word (e.g. "--exact") from a command
+// argument. Only a whole word counts, so "--exactly" is left alone.
+// -----------------------------------------------------------------------------
+static bool _lcms_takeFlag(string& args, const string& flag) {
+    if (args.compare(0, flag.size(), flag) != 0) return false;
+    if (args.size() > flag.size() && args[flag.size()] != ' ' && args[flag.size()] != '\t') return false;
+    args = _lcms_trim(args.substr(flag.size()));
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// _lcms_parseYearRange: "<from>-<to>" or a single "<year>" (either end may be
+// negative, e.g. "-500--300"). The separator is the first '-' after the first
+// character, so a leading minus always belongs to 'from'.
+// -----------------------------------------------------------------------------
+static bool _lcms_parseYearRange(const string& s, int& from, int& to) {
+    size_t dash = (s.size() > 1) ? s.find('-', 1) : string::npos;
+    if (dash == string::npos) {
+        if (!_lcms_parseYear(s, from)) return false;
+        to = from;
+        return true;
     }
-    fieldsOut.push_back(_lcms_trim(cur));
-    return fieldsOut.size() == 5;
+    return _lcms_parseYearSpan(s.data(), (int)dash, from) &&
+           _lcms_parseYearSpan(s.data() + dash + 1, (int)(s.size() - dash - 1), to) &&
+           from <= to;
 }
 
 // -----------------------------------------------------------------------------
@@ -208,7 +382,7 @@ static string _lcms_nodePath(const Node* n) {
     if (chain.size() <= 1) return "";
 
     string out = "";
-    for (int i = chain.size() - 2; i >= 0; --i) {
+    for (int i = (int)chain.size() - 2; i >= 0; --i) {
         if (out.size() > 0) out += "/";
         out += chain[i]->getName();
     }
@@ -222,24 +396,49 @@ static string _lcms_nodePath(const Node* n) {
 static void _lcms_collectCategoriesPostOrder(Node* node, MyVector<Node*>& out) {
     if (!node) return;
     MyVector<Node*>& kids = node->getChildren();
-    for (int i = 0; i < kids.size(); ++i) _lcms_collectCategoriesPostOrder(kids[i], out);
+    for (size_t i = 0; i < kids.size(); ++i) _lcms_collectCategoriesPostOrder(kids[i], out);
     out.push_back(node);
 }
 
 // -----------------------------------------------------------------------------
-// _lcms_collectMatches: One DFS that collects category+book matches at once.
-// Saves me from doing two separate traversals for the find() command.
+// _lcms_bookHasKeyword: The find() rule — keyword inside title, author, ISBN or year.
+// -----------------------------------------------------------------------------
+static bool _lcms_bookHasKeyword(const Book* b, const string& keyword) {
+    return (b->getTitle().find(keyword)  != string::npos) ||
+           (b->getAuthor().find(keyword) != string::npos) ||
+           (b->getISBN().find(keyword)   != string::npos) ||
+           (to_string(b->getYear()).find(keyword) != string::npos);
+}
+
+// -----------------------------------------------------------------------------
+// _lcms_collectMatches: Collect category+book matches for the find() command.
+// The Tree's word index hands back only the books/categories that share a word
+// with the keyword; those are checked with the same substring rule and sorted
+// into DFS order, so the output matches a full walk. Keywords without any
+// letters or digits (e.g. "-") fall back to one DFS over everything.
 // -----------------------------------------------------------------------------
 static void _lcms_collectMatches(Tree* tree, const string& keyword, MyVector<Node*>& categoryOut, MyVector<Book*>& bookOut) {
     if (!tree || !tree->getRoot()) return;
 
+    MyVector<Book*> bookCandidates;
+    MyVector<Node*> nodeCandidates;
+    if (tree->keywordCandidates(keyword, bookCandidates, nodeCandidates)) {
+        for (size_t i = 0; i < nodeCandidates.size(); ++i) {
+            if (nodeCandidates[i]->getName().find(keyword) != string::npos) categoryOut.push_back(nodeCandidates[i]);
+        }
+        for (size_t i = 0; i < bookCandidates.size(); ++i) {
+            if (_lcms_bookHasKeyword(bookCandidates[i], keyword)) bookOut.push_back(bookCandidates[i]);
+        }
+        tree->sortByCatalogOrder(categoryOut);
+        tree->sortByCatalogOrder(bookOut);
+        return;
+    }
+
     MyVector<Node*> stack;
     stack.push_back(tree->getRoot());
 
     while (!stack.empty()) {
-        int last = stack.size() - 1;
-        Node* cur = stack[last];
-        stack.removeAt(last);
+        Node* cur = stack.pop_back();
 
         // Category name match (skip showing the root as a “match”).
         if (cur != tree->getRoot()) {
@@ -249,18 +448,12 @@ static void _lcms_collectMatches(Tree* tree, const string& keyword, MyVector<Nod
         }
         // Book field match (title/author/isbn/year)
         MyVector<Book*>& books = cur->getBooks();
-        for (int i = 0; i < books.size(); ++i) {
-            Book* b = books[i];
-            bool match =
-                (b->getTitle().find(keyword)  != string::npos) ||
-                (b->getAuthor().find(keyword) != string::npos) ||
-                (b->getISBN().find(keyword)   != string::npos) ||
-                (to_string(b->getYear()).find(keyword) != string::npos);
-            if (match) bookOut.push_back(b);
+        for (size_t i = 0; i < books.size(); ++i) {
+            if (_lcms_bookHasKeyword(books[i], keyword)) bookOut.push_back(books[i]);
         }
         // Keep walking
         MyVector<Node*>& kids = cur->getChildren();
-        for (int i = 0; i < kids.size(); ++i) stack.push_back(kids[i]);
+        for (size_t i = 0; i < kids.size(); ++i) stack.push_back(kids[i]);
     }
 }
 
@@ -289,7 +482,7 @@ static void _lcms_printBookDetails(const Book* book) {
 // _lcms_printBookCollection: Just loop _lcms_printBookDetails with spacing (to print the book collection)
 // -----------------------------------------------------------------------------
 static void _lcms_printBookCollection(const MyVector<Book*>& books) {
-    for (int i = 0; i < books.size(); ++i) {
+    for (size_t i = 0; i < books.size(); ++i) {
         _lcms_printBookDetails(books[i]);
         if (i + 1 < books.size()) cout << endl;
     }
@@ -312,83 +505,182 @@ static string _lcms_lastSegment(const string& path) {
     return result;
 }
 
-// -----------------------------------------------------------------------------
-// _lcms_libraryContains: DFS check for a duplicate Book (uses operator==).
-// I call this before adding or after editing to avoid duplicate entries.
-// -----------------------------------------------------------------------------
-static bool _lcms_libraryContains(Tree* tree, const Book& b) {
-    MyVector<Node*> stack;
-    stack.push_back(tree->getRoot());
-
-    while (!stack.empty()) {
-        int last = stack.size() - 1;
-        Node* cur = stack[last];
-        stack.removeAt(last);
-
-        MyVector<Book*>& local = cur->getBooks();
-        for (int i = 0; i < local.size(); ++i) {
-            if (*(local[i]) == b) return true;
-        }
-        MyVector<Node*>& kids = cur->getChildren();
-        for (int i = 0; i < kids.size(); ++i) stack.push_back(kids[i]);
-    }
-    return false;
-}
-
-// ---------------------------------------------------------------------------------
-// _lcms_libraryContainsExcept: Same as above but ignore a specific Book* pointer.
-// This is handy during edits so we don’t “collide” with the very book we’re editing.
-// ---------------------------------------------------------------------------------
-static bool _lcms_libraryContainsExcept(Tree* tree, const Book& b, const Book* skip) {
-    MyVector<Node*> stack;
-    stack.push_back(tree->getRoot());
-
-    while (!stack.empty()) {
-        int last = stack.size() - 1;
-        Node* cur = stack[last];
-        stack.removeAt(last);
-
-        MyVector<Book*>& local = cur->getBooks();
-        for (int i = 0; i < local.size(); ++i) {
-            if (local[i] == skip) continue;
-            if (*(local[i]) == b) return true;
-        }
-        MyVector<Node*>& kids = cur->getChildren();
-        for (int i = 0; i < kids.size(); ++i) stack.push_back(kids[i]);
+// -----------------------------------------------------------------------------------
+// _lcms_exportLocalBooks: Write the books stored directly in 'node' as CSV lines
+// (Title,Author,ISBN,Year,Category). The quoted category path is built once per
+// node, not per book, and every field is formatted straight into the writer's buffer.
+// -----------------------------------------------------------------------------------
+static int _lcms_exportLocalBooks(const Node* node, const string& myPath, CSVWriter& out) {
+    const MyVector<Book*>& books = node->getBooks();
+    if (books.size() == 0) return 0;
+
+    string quotedPath = quoteCSV(myPath);
+    for (size_t i = 0; i < books.size(); ++i) {
+        const Book* b = books[i];
+        out.appendQuoted(b->getTitle());  out.appendChar(',');
+        out.appendQuoted(b->getAuthor()); out.appendChar(',');
+        out.appendQuoted(b->getISBN());   out.appendChar(',');
+        out.appendInt(b->getYear());      out.appendChar(',');
+        out.appendRaw(quotedPath);
+        out.endRow();
     }
-    return false;
+    return books.size();
 }
 
 // -----------------------------------------------------------------------------------
 // _lcms_dfsExport: Preorder over nodes; write each book’s row with full category path.
 // Returns number of rows written so the caller can print a friendly summary.
 // -----------------------------------------------------------------------------------
-static int _lcms_dfsExport(Node* node, const string& pathPrefix, ofstream& out) {
+static int _lcms_dfsExport(const Node* node, const string& pathPrefix, CSVWriter& out) {
     // Build path for this node (skip root name); reuse prefix for children.
     string myPath = pathPrefix;
     if (node->getParent() != nullptr) {
-        string segment = node->getName();
         if (myPath.size() > 0) myPath += "/";
-        myPath += segment;
+        myPath += node->getName();
     }
 
-    int written = 0;
-
-    // Write all local books as CSV lines: Title,Author,ISBN,Year,Category
-    MyVector<Book*>& books = node->getBooks();
-    for (int i = 0; i < books.size(); ++i) {
-        out << books[i]->toCSV() << "," << quoteCSV(myPath) << "\n";
-        written++;
-    }
+    int written = _lcms_exportLocalBooks(node, myPath, out);
 
     // Recurse into children to cover the entire subtree.
-    MyVector<Node*>& kids = node->getChildren();
-    for (int i = 0; i < kids.size(); ++i) {
+    const MyVector<Node*>& kids = node->getChildren();
+    for (size_t i = 0; i < kids.size(); ++i) {
         written += _lcms_dfsExport(kids[i], myPath, out);
     }
     return written;
 }
 
+// -----------------------------------------------------------------------------
+// _lcms_Workers: Worker threads held by value. The destructor joins every one
+// still running, so an early exit (an exception while merging, say) never
+// leaves a joinable std::thread behind, which would call std::terminate.
+// spawn() reports a thread the OS refused to start (std::system_error, e.g.
+// EAGAIN) instead of throwing; callers do that share of the work themselves.
+// -----------------------------------------------------------------------------
+struct _lcms_Workers
+{
+    MyVector<thread> threads;
+
+    explicit _lcms_Workers(int expected) { threads.reserve((size_t)expected); }
+    ~_lcms_Workers() { for (size_t i = 0; i < threads.size(); ++i) join(i); }
+
+    template <typename F>
+    bool spawn(F work) {
+        try {
+            threads.emplace_back(work);
+        } catch (const system_error&) {
+            return false;
+        }
+        return true;
+    }
+
+    void join(size_t i) { if (threads[i].joinable()) threads[i].join(); }
+    size_t size() const { return threads.size(); }
+};
+
+// -----------------------------------------------------------------------------------
+// _lcms_parallelExport: Same rows, same order as _lcms_dfsExport(root, ...), but
+// each top-level category subtree is formatted into its own in-memory buffer on
+// a pool of worker threads. The calling thread writes the root's own books, then
+// each subtree buffer in child order as soon as it is ready, so the file is
+// byte-identical to a serial export. The tree is only read while this runs.
+// If no worker could be started, the subtrees are exported serially.
+// -----------------------------------------------------------------------------------
+static int _lcms_parallelExport(const Node* root, int threads, CSVWriter& out) {
+    // Books directly under the root come first in preorder.
+    int written = _lcms_exportLocalBooks(root, "", out);
+
+    const MyVector<Node*>& kids = root->getChildren();
+    int parts = kids.size();
+    if (parts == 0) return written;
+    if (threads > parts) threads = parts;
+
+    // One slot per subtree; workers only touch their own slots, under doneLock
+    MyVector<string> texts;
+    MyVector<int> counts;
+    MyVector<char> done;
+    for (int i = 0; i < parts; ++i) { texts.push_back(string()); counts.push_back(0); done.push_back(0); }
+
+    atomic<int> nextPart(0);
+    mutex doneLock;
+    condition_variable doneSignal;
+
+    // Workers grab the next unclaimed subtree until none are left.
+    // (Declared after the slots so an early exit joins them before the slots go.)
+    _lcms_Workers workers(threads);
+    for (int t = 0; t < threads; ++t) {
+        bool started = workers.spawn([&]() {
+            while (true) {
+                int i = nextPart.fetch_add(1);
+                if (i >= parts) return;
+                CSVWriter buffer(nullptr); // in-memory
+                int rows = _lcms_dfsExport(kids[i], "", buffer);
+                lock_guard<mutex> guard(doneLock);
+                buffer.takePending(texts[i]);
+                counts[i] = rows;
+                done[i] = 1;
+                doneSignal.notify_all();
+            }
+        });
+        if (!started) break;
+    }
+    if (workers.size() == 0) {
+        for (int i = 0; i < parts; ++i) written += _lcms_dfsExport(kids[i], "", out);
+        return written;
+    }
+
+    // Write subtree buffers strictly in child order.
+    for (int i = 0; i < parts; ++i) {
+        {
+            unique_lock<mutex> guard(doneLock);
+            while (!done[i]) doneSignal.wait(guard);
+        }
+        out.appendBlock(texts[i]);
+        written += counts[i];
+        string().swap(texts[i]); // give the memory back as we go
+    }
+    return written;
+}
+
+// -----------------------------------------------------------------------------
+// _lcms_fileExists: True if 'path' can be opened for reading.
+// -----------------------------------------------------------------------------
+static bool _lcms_fileExists(const string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    fclose(f);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// _lcms_sameFields: Exact field comparison (Book::operator== is the looser
+// duplicate rule, which is not what journal replay needs).
+// -----------------------------------------------------------------------------
+static bool _lcms_sameFields(const Book& a, const Book& b) {
+    return a.getTitle() == b.getTitle() && a.getAuthor() == b.getAuthor() &&
+           a.getISBN() == b.getISBN() && a.getYear() == b.getYear();
+}
+
+// -----------------------------------------------------------------------------
+// _lcms_findExactBook: The book in 'node' whose fields are exactly 'values'.
+// -----------------------------------------------------------------------------
+static Book* _lcms_findExactBook(Node* node, const Book& values) {
+    if (!node) return nullptr;
+    const MyVector<Book*>& local = node->getBooks();
+    for (size_t i = 0; i < local.size(); ++i) {
+        if (_lcms_sameFields(*local[i], values)) return local[i];
+    }
+    return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// _lcms_bookRecord: Fill a journal record that names one book by its node path.
+// -----------------------------------------------------------------------------
+static void _lcms_bookRecord(JournalRecord& record, int op, const string& path, const Book& book) {
+    record.op = op;
+    record.path = path;
+    record.book = book;
+}
+
 /* ===============================
    LCMS methods (public interface)
    These are the functions the CLI (or main) would call directly.
@@ -400,91 +692,392 @@ static int _lcms_dfsExport(Node* node, const string& pathPrefix, ofstream& out)
 // --------------------------------------------------------
 LCMS::LCMS(string name) {
     libTree = new Tree(name);
+    unorderedBooks = false;
+    journal = nullptr;
+    checkpointSeq = 0;
+    lastCheckpoint = chrono::steady_clock::now();
 }
 
 // --------------------------------------------------------
-// dtor: delete the Tree; Node destructor recursively frees all.
-// This avoids memory leaks because Nodes own books and children.
+// setUnorderedBooks: remember the mode and apply it to the current tree;
+// trees loaded later (snapshots) get it too.
+// --------------------------------------------------------
+void LCMS::setUnorderedBooks(bool on) {
+    unorderedBooks = on;
+    libTree->setUnorderedBooks(on);
+}
+
+// --------------------------------------------------------
+// dtor: delete the Tree; it releases every node and book to its pools,
+// which then free their slabs in one pass.
 // --------------------------------------------------------
 LCMS::~LCMS() {
+    delete journal; // flushes anything still queued
+    journal = nullptr;
     delete libTree;
     libTree = nullptr;
 }
 
 // ---------------------------------------------------------------------
-// import: Read CSV lines, validate fields, normalize category paths,
-// skip duplicates, and create missing nodes on the fly. Prints how many
-// records got imported so the user knows it worked.
+// openCatalog: Load the base snapshot, replay the journal records it does
+// not already contain (the snapshot header says how far it goes), cut off
+// a torn tail left by a crash, and keep the journal open for appending.
+// A retired segment left by an unfinished checkpoint is replayed first and
+// folded into a new checkpoint right away.
 // ---------------------------------------------------------------------
-int LCMS::import(string path) {
-    ifstream fin(path.c_str());
-    if (!fin.is_open()) return -1; // Couldn't open file (per spec, return -1)
-
-    int importedCount = 0;
-    string line;
-    bool firstLine = true;
-
-    // Read file line-by-line. I treat the first "Title,..." as a header to skip.
-    while (std::getline(fin, line)) {
-        if (firstLine) {
-            firstLine = false;
-            if (line.size() >= 6 && line.substr(0, 6) == "Title,") continue; // skip header
+bool LCMS::openCatalog(string snapshotFile, string journalFile) {
+    baseSnapshot = _lcms_trim(snapshotFile);
+    journalFile = _lcms_trim(journalFile);
+
+    uint64_t snapshotSeq = 0;
+    if (baseSnapshot.size() > 0 && _lcms_fileExists(baseSnapshot)) {
+        string error;
+        Tree* loaded = snapshotLoad(baseSnapshot, error, &snapshotSeq);
+        if (!loaded) {
+            cout << "Could not load snapshot " << baseSnapshot << ": " << error << endl;
+            return false;
         }
+        delete libTree;
+        libTree = loaded;
+        libTree->setUnorderedBooks(unorderedBooks);
+        cout << libTree->getRoot()->getBookCount() << " records have been loaded from snapshot " << baseSnapshot << endl;
+    }
+    if (journalFile.size() == 0) return true;
+
+    // Replay everything newer than the snapshot: retired segment, then the live journal.
+    string segments[2] = { journalRetiredPath(journalFile), journalFile };
+    uint64_t lastSeq = snapshotSeq;
+    size_t validBytes = 0;
+    int replayed = 0, rejected = 0;
+    for (int s = 0; s < 2; ++s) {
+        JournalReader reader;
+        bool exists = false;
+        if (!reader.open(segments[s], exists)) {
+            cout << segments[s] << " is not a catalog journal." << endl;
+            return false;
+        }
+        JournalRecord record;
+        while (reader.next(record)) {
+            if (record.seq > lastSeq) lastSeq = record.seq;
+            if (record.seq <= snapshotSeq) continue;
+            if (replayRecord(record)) replayed++;
+            else rejected++;
+        }
+        if (reader.sawDamage()) {
+            cout << "Journal " << segments[s] << " ends in a damaged record; it has been cut off." << endl;
+        }
+        if (s == 1) validBytes = exists ? reader.validBytes() : 0;
+    }
+
+    journal = new Journal();
+    if (!journal->open(journalFile, validBytes, lastSeq + 1)) {
+        delete journal;
+        journal = nullptr;
+        cout << "Could not open journal " << journalFile << endl;
+        return false;
+    }
+
+    if (rejected > 0) cout << rejected << " journal records no longer matched the catalog and were skipped." << endl;
+    cout << replayed << " journal records have been replayed from " << journalFile << endl;
+
+    checkpointSeq = snapshotSeq;
+    lastCheckpoint = chrono::steady_clock::now();
+    if (_lcms_fileExists(segments[0])) startCheckpoint();
+    return true;
+}
+
+// ---------------------------------------------------------------------
+// startCheckpoint: Runs on the command thread between commands (or import
+// rows), so the tree is consistent with the journal position. The journal is
+// committed and renamed to its retired name first; new commands keep
+// journaling into a fresh file while the Checkpointer encodes and saves the
+// tree from a frozen copy (see checkpoint.hpp). The retired file is only
+// deleted after the snapshot is safely on disk. If a failed checkpoint left a
+// retired file behind, it is kept (not overwritten) and this checkpoint, which
+// covers it too, removes it instead.
+// ---------------------------------------------------------------------
+bool LCMS::startCheckpoint() {
+    if (!journal || checkpointer.isBusy()) return false;
+    journalCommit();
+
+    string retired = journalRetiredPath(journal->getPath());
+    if (!_lcms_fileExists(retired) && !journal->rotate(retired)) return false;
+
+    uint64_t seq = journal->lastSeq();
+    lastCheckpoint = chrono::steady_clock::now();
+    if (!checkpointer.start(*libTree, seq, baseSnapshot, retired)) return false;
+    checkpointSeq = seq;
+    return true;
+}
+
+// ---------------------------------------------------------------------
+// checkpoint: Manual trigger; the write itself still happens in the background.
+// ---------------------------------------------------------------------
+void LCMS::checkpoint() {
+    if (!journal) {
+        cout << "Checkpoints need a journal (start with --snapshot <file> --journal <file>)." << endl;
+        return;
+    }
+    if (checkpointer.isBusy()) {
+        cout << "A checkpoint is already being written." << endl;
+        return;
+    }
+    if (!startCheckpoint()) {
+        cout << "Could not start a checkpoint." << endl;
+        return;
+    }
+    cout << "Checkpoint of " << libTree->getRoot()->getBookCount() << " records is being written to " << baseSnapshot << endl;
+}
 
-        // Parse CSV into exactly 5 fields.
-        MyVector<string> fields;
-        if (!_lcms_parseCSVLine(line, fields)) continue;
+// ---------------------------------------------------------------------
+// maybeCheckpoint: Cheap check after every command (and every few thousand
+// imported rows, so a long import checkpoints too); starts a checkpoint
+// once enough records piled up (or they have waited long enough), and
+// reports a background failure the first time the loop comes back here.
+// ---------------------------------------------------------------------
+void LCMS::maybeCheckpoint() {
+    if (!journal) return;
+    if (checkpointer.takeFailure()) {
+        cout << "Warning: checkpoint to " << baseSnapshot << " failed; the journal still holds every change." << endl;
+    }
 
-        // Unpack and validate.
-        string title  = fields[0];
-        string author = fields[1];
-        string isbn   = fields[2];
-        string yearS  = fields[3];
-        string cat    = fields[4];
+    uint64_t pending = journal->lastSeq() - checkpointSeq;
+    if (pending == 0) return;
+    int age = (int)chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now() - lastCheckpoint).count();
+    if (pending >= _LCMS_CHECKPOINT_RECORDS || age >= _LCMS_CHECKPOINT_SECONDS) startCheckpoint();
+}
 
-        int year = 0;
-        if (!_lcms_parseYear(yearS, year)) continue; // reject malformed year
+// ---------------------------------------------------------------------
+// journalAppend / journalCommit: Mutating commands queue one record per
+// change and commit once at the end, so a whole import shares one fsync.
+// ---------------------------------------------------------------------
+void LCMS::journalAppend(JournalRecord& record) {
+    if (journal) journal->append(record);
+}
+
+void LCMS::journalCommit() {
+    if (journal && !journal->commit()) {
+        cout << "Warning: could not write to the journal; recent changes may not survive a restart." << endl;
+    }
+}
 
-        // Normalize category path so “/CS//Algo/ ” becomes “CS/Algo”.
-        string pathNorm = _lcms_normalizePath(cat);
-        if (pathNorm.size() == 0) continue; // empty category isn’t allowed
+// ---------------------------------------------------------------------
+// replayRecord: Same rules as the interactive commands, minus the prompts.
+// Books are found by node path + exact fields, so a replay never touches
+// a different copy than the one that was edited or removed.
+// ---------------------------------------------------------------------
+bool LCMS::replayRecord(const JournalRecord& record) {
+    switch (record.op) {
+        case JOURNAL_ADD_BOOK: {
+            if (libTree->containsBook(record.book)) return false;
+            Node* node = libTree->createNode(record.path);
+            if (!node) return false;
+            return libTree->addBook(node, record.book) != nullptr;
+        }
+        case JOURNAL_EDIT_BOOK: {
+            Book* b = _lcms_findExactBook(libTree->getNode(record.path), record.book);
+            if (!b || libTree->containsBookExcept(record.edited, b)) return false;
+            libTree->updateBook(b, record.edited);
+            return true;
+        }
+        case JOURNAL_REMOVE_BOOK: {
+            Node* node = libTree->getNode(record.path);
+            return libTree->removeBook(node, _lcms_findExactBook(node, record.book));
+        }
+        case JOURNAL_ADD_CATEGORY:
+            return libTree->createNode(record.path) != nullptr;
+        case JOURNAL_EDIT_CATEGORY: {
+            Node* n = libTree->getNode(record.path);
+            if (!n) return false;
+            Node* parent = n->getParent();
+            Node* clash = parent ? parent->findChildByName(record.name) : nullptr;
+            if (clash && clash != n) return false;
+            libTree->renameNode(n, record.name);
+            return true;
+        }
+        case JOURNAL_REMOVE_CATEGORY:
+            return libTree->removeNode(record.path);
+        default:
+            return false;
+    }
+}
 
-        // Avoid duplicates anywhere in the library.
-        Book candidate(title, author, isbn, year);
-        if (_lcms_libraryContains(libTree, candidate)) continue;
+// ---------------------------------------------------------------------
+// import: Map the CSV, walk it line by line, validate fields, normalize
+// category paths, skip duplicates, and create missing nodes on the fly.
+// Fields stay views into the mapped file; strings are only filled (into
+// reused buffers) for rows that pass validation, and a Book is only
+// allocated for rows that are really added. Prints how many records got
+// imported so the user knows it worked.
+//
+// "import --threads N <file>" parses N newline-aligned chunks on worker
+// threads and merges them into the tree in file order, so duplicates and
+// the final count come out exactly like the serial path.
+// ---------------------------------------------------------------------
+int LCMS::import(string path) {
+    int threads = 1;
+    if (!_lcms_parseThreadsOption(path, threads)) {
+        cout << "Usage: import [--threads N] <file_name>" << endl;
+        return -1;
+    }
 
-        // Ensure the category exists (mkdir -p style).
-        Node* node = libTree->createNode(pathNorm);
-        if (!node) continue; // extremely unlikely, but safe to guard
+    MappedFile file;
+    if (!file.open(path)) return -1; // Couldn't open file (per spec, return -1)
 
-        // Finally add the book; free the heap object if insertion fails.
-        Book* added = new Book(title, author, isbn, year);
-        if (node->addBook(added)) {
+    const char* begin = file.data();
+    const char* end   = begin + file.size();
+    int importedCount = 0;
+    Book candidate;
+    JournalRecord record; // reused for every journaled row
+
+    // Tiny files are not worth the thread start-up cost.
+    if (threads > 1 && file.size() < _LCMS_MIN_PARALLEL_BYTES) threads = 1;
+
+    if (threads <= 1) {
+        _lcms_ImportRow row;
+        string scratch;
+        bool firstLine = true;
+        const char* p = begin;
+        while (p < end) {
+            if (!_lcms_parseImportRow(p, end, firstLine, row, scratch)) continue;
+            if (!_lcms_mergeImportRow(libTree, row, candidate)) continue;
             importedCount++;
-        } else {
-            delete added;
+            if (journal) { _lcms_bookRecord(record, JOURNAL_ADD_BOOK, row.path, candidate); journalAppend(record); }
+            if (importedCount % _LCMS_CHECKPOINT_CHECK_ROWS == 0) maybeCheckpoint();
+        }
+    } else {
+        // Cut the buffer into 'threads' pieces, each ending right after a newline.
+        MyVector<const char*> cuts;
+        cuts.push_back(begin);
+        for (int i = 1; i < threads; ++i) {
+            const char* guess = begin + (size_t)((double)file.size() * i / threads);
+            if (guess < cuts[cuts.size() - 1]) guess = cuts[cuts.size() - 1];
+            const char* nl = (const char*)memchr(guess, '\n', (size_t)(end - guess));
+            cuts.push_back(nl ? nl + 1 : end);
+        }
+        cuts.push_back(end);
+
+        // Workers only parse and validate into their own row lists; they never touch the Tree.
+        // A chunk whose worker could not be started is parsed here when its turn comes.
+        int chunkCount = cuts.size() - 1;
+        MyVector<MyVector<_lcms_ImportRow> > parsed;
+        for (int c = 0; c < chunkCount; ++c) parsed.push_back(MyVector<_lcms_ImportRow>());
+        auto parseChunk = [&parsed, &cuts](int c) {
+            MyVector<_lcms_ImportRow>& out = parsed[c];
+            _lcms_ImportRow row;
+            string scratch;
+            bool firstLine = (c == 0); // only the file's first line can be a header
+            const char* p = cuts[c];
+            const char* to = cuts[c + 1];
+            while (p < to) {
+                if (_lcms_parseImportRow(p, to, firstLine, row, scratch)) out.push_back(row);
+            }
+        };
+        // Declared after 'parsed' so an early exit joins the workers before their rows go.
+        _lcms_Workers workers(chunkCount);
+        for (int c = 0; c < chunkCount; ++c) {
+            if (!workers.spawn([&parseChunk, c]() { parseChunk(c); })) break;
+        }
+
+        // Merge chunk c as soon as its worker finishes, while later chunks keep parsing.
+        for (int c = 0; c < chunkCount; ++c) {
+            if ((size_t)c < workers.size()) workers.join(c);
+            else parseChunk(c);
+            MyVector<_lcms_ImportRow>& rows = parsed[c];
+            for (size_t i = 0; i < rows.size(); ++i) {
+                if (!_lcms_mergeImportRow(libTree, rows[i], candidate)) continue;
+                importedCount++;
+                if (journal) { _lcms_bookRecord(record, JOURNAL_ADD_BOOK, rows[i].path, candidate); journalAppend(record); }
+                if (importedCount % _LCMS_CHECKPOINT_CHECK_ROWS == 0) maybeCheckpoint();
+            }
+            MyVector<_lcms_ImportRow>().swap(rows);
         }
     }
 
+    // One commit (and fsync) for the whole file, plus one per checkpoint taken on the way.
+    journalCommit();
     cout << importedCount << " records have been imported." << endl;
     return 0;
 }
 
 // ---------------------------------------------------------------------
 // exportData: Write a CSV header and then every book row via preorder DFS.
+// Rows go through a CSVWriter, so the file is written in 1 MiB blocks.
+// "export --threads N <file>" formats top-level subtrees concurrently; the
+// output is byte-identical to the serial export.
 // I also print a friendly summary with the exported count and file path.
 // ---------------------------------------------------------------------
 void LCMS::exportData(string path) {
+    int threads = 1;
+    if (!_lcms_parseThreadsOption(path, threads)) {
+        cout << "Usage: export [--threads N] <file_name>" << endl;
+        return;
+    }
+
     ofstream fout(path.c_str());
     if (!fout.is_open()) return;
 
     // Header must match the grader’s expected string.
-    fout << "Title,Author,ISBN,Year,Category\n";
-    int exported = _lcms_dfsExport(libTree->getRoot(), "", fout);
+    CSVWriter writer(&fout);
+    writer.appendRaw("Title,Author,ISBN,Year,Category\n");
+    int exported = (threads > 1) ? _lcms_parallelExport(libTree->getRoot(), threads, writer)
+                                 : _lcms_dfsExport(libTree->getRoot(), "", writer);
+    writer.flush();
 
     cout << exported << " records have been successfully exported to " << path << endl;
 }
 
+// ---------------------------------------------------------------------
+// saveSnapshot: Flatten the tree into the binary snapshot format and write
+// it atomically (temp file + rename), then report how many books it holds.
+// ---------------------------------------------------------------------
+void LCMS::saveSnapshot(string path) {
+    string trimmed = _lcms_trim(path);
+    if (trimmed.size() == 0) {
+        cout << "Usage: save-snapshot <file_name>" << endl;
+        return;
+    }
+    // Stamp the journal position so a startup from this file skips what it already holds.
+    // (Wait out a background checkpoint first; it may be writing the same file.)
+    checkpointer.waitIdle();
+    if (!snapshotSave(*libTree, trimmed, journal ? journal->lastSeq() : 0)) {
+        cout << "Could not write snapshot to " << trimmed << endl;
+        return;
+    }
+    cout << libTree->getRoot()->getBookCount() << " records have been saved to snapshot " << trimmed << endl;
+}
+
+// ---------------------------------------------------------------------
+// loadSnapshot: Map a snapshot and rebuild the tree from it. The current
+// catalog is only replaced once the whole snapshot decoded successfully.
+// ---------------------------------------------------------------------
+void LCMS::loadSnapshot(string path) {
+    string trimmed = _lcms_trim(path);
+    if (trimmed.size() == 0) {
+        cout << "Usage: load-snapshot <file_name>" << endl;
+        return;
+    }
+
+    string error;
+    Tree* loaded = snapshotLoad(trimmed, error);
+    if (!loaded) {
+        cout << "Could not load snapshot " << trimmed << ": " << error << endl;
+        return;
+    }
+
+    delete libTree;
+    libTree = loaded;
+    libTree->setUnorderedBooks(unorderedBooks);
+    cout << libTree->getRoot()->getBookCount() << " records have been loaded from snapshot " << trimmed << endl;
+
+    // The journal only describes changes on top of the base snapshot, so the
+    // replaced catalog becomes the new base right away.
+    checkpointer.waitIdle();
+    if (journal && !snapshotSave(*libTree, baseSnapshot, journal->lastSeq())) {
+        cout << "Warning: could not update " << baseSnapshot << "; this load will not survive a restart." << endl;
+    }
+}
+
 // ---------------------------------------------------------------------
 // find: Unified keyword search. I collect category matches and book matches,
 // then print them in two clean sections so it reads nicely in the console.
@@ -506,7 +1099,7 @@ void LCMS::find(string keyword) {
     if (categoryMatches.size() == 0) {
         cout << "None" << endl;
     } else {
-        for (int i = 0; i < categoryMatches.size(); ++i) {
+        for (size_t i = 0; i < categoryMatches.size(); ++i) {
             cout << (i + 1) << ": " << _lcms_nodePath(categoryMatches[i]) << endl;
         }
     }
@@ -526,9 +1119,17 @@ void LCMS::find(string keyword) {
 // findByAuthor: Traverse the tree and list all books whose author string
 // contains the given text. This is a small extension feature and helps a lot
 // when students know the author but not the full title.
+// The plain form matches the text exactly as typed (case-sensitive substring),
+// whatever characters it contains. The front desk usually knows the author, so
+// two flagged forms skip the substring search entirely (via the author index);
+// both compare names case- and spacing-insensitively:
+//   findAuthor --exact Richard Dawkins  -> exactly that author
+//   findAuthor --prefix Dawk            -> authors starting with "Dawk"
 // ---------------------------------------------------------------------
 void LCMS::findByAuthor(string author) const {
     string trimmed = _lcms_trim(author);
+    bool exact = _lcms_takeFlag(trimmed, "--exact");
+    bool prefix = !exact && _lcms_takeFlag(trimmed, "--prefix");
     if (trimmed.size() == 0) {
         cout << "Author query cannot be empty." << endl;
         return;
@@ -539,18 +1140,45 @@ void LCMS::findByAuthor(string author) const {
         return;
     }
 
+    if (exact || prefix) {
+        MyVector<Book*> found;
+        if (exact) libTree->findAuthorExact(trimmed, found);
+        else       libTree->findAuthorPrefix(trimmed, found);
+
+        string what = exact ? "author <" + trimmed + ">" : "author starting with <" + trimmed + ">";
+        if (found.size() == 0) {
+            cout << "No books found by " << what << "." << endl;
+            return;
+        }
+        cout << "Books found by " << what << ":" << endl;
+        cout << "============================================================" << endl;
+        _lcms_printBookCollection(found);
+        cout << "============================================================" << endl;
+        _lcms_printCountLine(found.size(), "Book", "Books");
+        return;
+    }
+
     MyVector<Book*> matches;
+    MyVector<Book*> candidates;
     MyVector<Node*> stack;
-    stack.push_back(libTree->getRoot());
+
+    // Author word index first: only its candidates need the substring test.
+    // They come back unordered, so sort them into the DFS order of the walk below.
+    if (libTree->authorCandidates(trimmed, candidates)) {
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (candidates[i]->getAuthor().find(trimmed) != string::npos) matches.push_back(candidates[i]);
+        }
+        libTree->sortByCatalogOrder(matches);
+    } else {
+        stack.push_back(libTree->getRoot());
+    }
 
     // DFS over every node; check each local book’s author field.
     while (!stack.empty()) {
-        int last = stack.size() - 1;
-        Node* cur = stack[last];
-        stack.removeAt(last);
+        Node* cur = stack.pop_back();
 
         const MyVector<Book*>& books = cur->getBooks();
-        for (int i = 0; i < books.size(); ++i) {
+        for (size_t i = 0; i < books.size(); ++i) {
             Book* candidate = books[i];
             if (candidate && candidate->getAuthor().find(trimmed) != string::npos) {
                 matches.push_back(candidate);
@@ -558,7 +1186,7 @@ void LCMS::findByAuthor(string author) const {
         }
 
         const MyVector<Node*>& children = cur->getChildren();
-        for (int i = 0; i < children.size(); ++i) {
+        for (size_t i = 0; i < children.size(); ++i) {
             stack.push_back(children[i]);
         }
     }
@@ -647,7 +1275,7 @@ void LCMS::addBook() {
 
     // Quick duplicate check across the whole library.
     Book candidate(title, author, isbn, year);
-    if (_lcms_libraryContains(libTree, candidate)) {
+    if (libTree->containsBook(candidate)) {
         cout << "Book already exists in the catalog." << endl;
         return;
     }
@@ -660,22 +1288,90 @@ void LCMS::addBook() {
     }
 
     // Save the book and report the success in the same tone as the samples.
-    Book* added = new Book(title, author, isbn, year);
-    if (node->addBook(added)) {
+    Book* added = libTree->addBook(node, Book(title, author, isbn, year));
+    if (added) {
+        JournalRecord record;
+        _lcms_bookRecord(record, JOURNAL_ADD_BOOK, norm, *added);
+        journalAppend(record);
+        journalCommit();
         cout << title << " has been successfully added into the Catalog." << endl;
     } else {
-        delete added;
         cout << "Book already exists in the selected category." << endl;
     }
 }
 
+// ---------------------------------------------------------------------
+// findISBN: Same detail block as findBook, but keyed on the ISBN. The Tree's
+// ISBN index normalizes the query the same way as stored ISBNs, so
+// "0-14-044913-X" finds a book stored as "9780140449136".
+// ---------------------------------------------------------------------
+void LCMS::findISBN(string isbn) {
+    string trimmed = _lcms_trim(isbn);
+    if (trimmed.size() == 0) {
+        cout << "ISBN query cannot be empty." << endl;
+        return;
+    }
+    Book* b = libTree->findISBN(trimmed);
+    if (!b) {
+        cout << "Book not found in the library." << endl;
+        return;
+    }
+    cout << "Book found in the library:" << endl;
+    _lcms_printBookDetails(b);
+}
+
+// ---------------------------------------------------------------------
+// findYear: "findYear 1950-1970 [category]". The Tree's year index jumps
+// straight to the first year in range, so this never walks the catalog;
+// results come out by year, then in the usual catalog order.
+// ---------------------------------------------------------------------
+void LCMS::findYear(string args) {
+    string trimmed = _lcms_trim(args);
+    size_t space = trimmed.find_first_of(" \t");
+    string range = trimmed.substr(0, space);
+    string category = (space == string::npos) ? "" : _lcms_trim(trimmed.substr(space));
+
+    int from = 0, to = 0;
+    if (!_lcms_parseYearRange(range, from, to)) {
+        cout << "Usage: findYear <from>-<to> [category]  (e.g. findYear 1950-1970 Science)" << endl;
+        return;
+    }
+
+    const Node* scope = nullptr;
+    string norm = _lcms_normalizePath(category);
+    if (norm.size() > 0) {
+        scope = libTree->getNode(norm);
+        if (!scope) {
+            cout << "No such category/sub-category found in the Catalog." << endl;
+            return;
+        }
+    }
+
+    MyVector<Book*> found;
+    libTree->findYearRange(from, to, scope, found);
+
+    string what = (from == to) ? "in <" + to_string(from) + ">"
+                               : "between <" + to_string(from) + "> and <" + to_string(to) + ">";
+    if (scope) what += " under <" + norm + ">";
+    if (found.size() == 0) {
+        cout << "No books published " << what << "." << endl;
+        return;
+    }
+    cout << "Books published " << what << ":" << endl;
+    cout << "============================================================" << endl;
+    _lcms_printBookCollection(found);
+    cout << "============================================================" << endl;
+    _lcms_printCountLine(found.size(), "Book", "Books");
+}
+
 // ---------------------------------------------------------------------
 // editBook: Small loop with numbered options. I allow blank input to “keep”
-// the current value. If the edit would duplicate an existing record, I
-// revert to the original fields and tell the user.
+// the current value. Edits go into a working copy; if the result would
+// duplicate an existing record, the stored book is left untouched.
 // ---------------------------------------------------------------------
 void LCMS::editBook(string bookTitle) {
-    Book* b = libTree->findBook(bookTitle);
+    Node* owner = nullptr;
+    Book* b = libTree->findBook(bookTitle, &owner);
     if (!b) {
         cout << "Book not found in the library." << endl;
         return;
@@ -684,11 +1380,8 @@ void LCMS::editBook(string bookTitle) {
     cout << "Book found in the library:" << endl;
     _lcms_printBookDetails(b);
 
-    // Keep a copy so I can roll back if the updated record collides.
-    string originalTitle  = b->getTitle();
-    string originalAuthor = b->getAuthor();
-    string originalISBN   = b->getISBN();
-    int    originalYear   = b->getYear();
+    // Work on a copy so the Tree can re-index the book in one step at the end.
+    Book edited = *b;
 
     // Simple editing menu. I keep it basic so it’s easy to test.
     while (true) {
@@ -705,21 +1398,21 @@ void LCMS::editBook(string bookTitle) {
         if (choice == "1") {
             cout << "Enter Title: ";
             string v; std::getline(cin, v);
-            if (_lcms_trim(v).size() > 0) b->setTitle(v);
+            if (_lcms_trim(v).size() > 0) edited.setTitle(v);
         } else if (choice == "2") {
             cout << "Enter Author(s): ";
             string v; std::getline(cin, v);
-            if (_lcms_trim(v).size() > 0) b->setAuthor(v);
+            if (_lcms_trim(v).size() > 0) edited.setAuthor(v);
         } else if (choice == "3") {
             cout << "Enter ISBN: ";
             string v; std::getline(cin, v);
-            if (_lcms_trim(v).size() > 0) b->setISBN(v);
+            if (_lcms_trim(v).size() > 0) edited.setISBN(v);
         } else if (choice == "4") {
             cout << "Enter Publication Year: ";
             string v; std::getline(cin, v);
             if (_lcms_trim(v).size() > 0) {
                 int parsed = 0;
-                if (_lcms_parseYear(v, parsed)) b->setYear(parsed);
+                if (_lcms_parseYear(v, parsed)) edited.setYear(parsed);
                 else cout << "Invalid publication year." << endl;
             }
         } else {
@@ -727,14 +1420,19 @@ void LCMS::editBook(string bookTitle) {
         }
     }
 
-    // If the edited book would be a duplicate, undo the changes.
-    if (_lcms_libraryContainsExcept(libTree, *b, b)) {
-        b->setTitle(originalTitle);
-        b->setAuthor(originalAuthor);
-        b->setISBN(originalISBN);
-        b->setYear(originalYear);
+    // If the edited book would be a duplicate, drop the changes.
+    if (libTree->containsBookExcept(edited, b)) {
         cout << "Edit would create a duplicate; changes reverted." << endl;
+        return;
     }
+    if (_lcms_sameFields(*b, edited)) return; // nothing changed, nothing to journal
+
+    JournalRecord record;
+    _lcms_bookRecord(record, JOURNAL_EDIT_BOOK, _lcms_nodePath(owner), *b);
+    record.edited = edited;
+    libTree->updateBook(b, edited);
+    journalAppend(record);
+    journalCommit();
 }
 
 // ---------------------------------------------------------------------
@@ -742,7 +1440,8 @@ void LCMS::editBook(string bookTitle) {
 // I mirror the professor’s wording so the console output looks familiar.
 // ---------------------------------------------------------------------
 void LCMS::removeBook(string bookTitle) {
-    Book* b = libTree->findBook(bookTitle);
+    Node* owner = nullptr;
+    Book* b = libTree->findBook(bookTitle, &owner);
     if (!b) {
         cout << "Book not found in the library." << endl;
         return;
@@ -758,7 +1457,12 @@ void LCMS::removeBook(string bookTitle) {
         return;
     }
 
-    if (libTree->removeBookByTitle(bookTitle)) {
+    // Remove exactly the book that was shown (record it before it is freed).
+    JournalRecord record;
+    _lcms_bookRecord(record, JOURNAL_REMOVE_BOOK, _lcms_nodePath(owner), *b);
+    if (libTree->removeBook(owner, b)) {
+        journalAppend(record);
+        journalCommit();
         cout << "Book \"" << bookTitle << "\" has been deleted from the library" << endl;
     } else {
         cout << "Book \"" << bookTitle << "\" could not be deleted." << endl;
@@ -798,6 +1502,11 @@ void LCMS::addCategory(string category) {
     if (existed) {
         cout << label << " already exists in the Catalog." << endl;
     } else if (created) {
+        JournalRecord record;
+        record.op = JOURNAL_ADD_CATEGORY;
+        record.path = norm;
+        journalAppend(record);
+        journalCommit();
         cout << label << " has been successfully created." << endl;
     } else {
         cout << "Could not create the category." << endl;
@@ -828,16 +1537,21 @@ void LCMS::editCategory(string category) {
     // Check sibling names to avoid duplicates like “CS/Algo” and “CS/Algo”.
     Node* parent = n->getParent();
     if (parent != nullptr) {
-        MyVector<Node*>& siblings = parent->getChildren();
-        for (int i = 0; i < siblings.size(); ++i) {
-            if (siblings[i] != n && siblings[i]->getName() == trimmed) {
-                cout << "Duplicate category name under the same parent.\n";
-                return;
-            }
+        Node* clash = parent->findChildByName(trimmed);
+        if (clash != nullptr && clash != n) {
+            cout << "Duplicate category name under the same parent.\n";
+            return;
         }
     }
 
-    n->setName(trimmed);
+    libTree->renameNode(n, trimmed);
+
+    JournalRecord record;
+    record.op = JOURNAL_EDIT_CATEGORY;
+    record.path = norm;
+    record.name = trimmed;
+    journalAppend(record);
+    journalCommit();
     cout << "Category renamed to: " << trimmed << "\n";
 }
 
@@ -873,21 +1587,27 @@ void LCMS::removeCategory(string category) {
     // Print each book that will be removed (matches sample output style).
     MyVector<Book*> doomedBooks;
     target->collectBooksInSubtree(doomedBooks);
-    for (int i = 0; i < doomedBooks.size(); ++i) {
+    for (size_t i = 0; i < doomedBooks.size(); ++i) {
         cout << "Book \"" << doomedBooks[i]->getTitle() << "\" has been deleted from the library" << endl;
     }
 
     // Print sub-categories in post-order (children before the parent).
     MyVector<Node*> doomedCategories;
     _lcms_collectCategoriesPostOrder(target, doomedCategories);
-    for (int i = 0; i < doomedCategories.size(); ++i) {
+    for (size_t i = 0; i < doomedCategories.size(); ++i) {
         if (doomedCategories[i] == target) continue;
         cout << "Category \"" << doomedCategories[i]->getName() << "\" has been deleted from the Library." << endl;
     }
 
-    // Actually remove the subtree via the Tree wrapper.
-    if (libTree->removeChild(parent, target->getName())) {
-        cout << "Category \"" << target->getName() << "\" has been deleted from the Library." << endl;
+    // Actually remove the subtree via the Tree wrapper (keep the name; target is freed).
+    string targetName = target->getName();
+    if (libTree->removeChild(parent, targetName)) {
+        JournalRecord record;
+        record.op = JOURNAL_REMOVE_CATEGORY;
+        record.path = norm;
+        journalAppend(record);
+        journalCommit();
+        cout << "Category \"" << targetName << "\" has been deleted from the Library." << endl;
     } else {
         cout << "Category removal failed.\n";
     }
@@ -6,12 +6,19 @@ void listCommands()
 	cout<<" ===================================================================================="<<endl
         <<" Welcome to the Library Catalog Management System!\n"<<endl
         <<" List of available Commands:"<<endl
-		<<" import <file_name>                          : Read a Book file from a file"<<endl
-		<<" export <file_name>                          : Export Books to a file"<<endl
+		<<" import [--threads N] <file_name>            : Read a Book file from a file"<<endl
+		<<" export [--threads N] <file_name>            : Export Books to a file"<<endl
+		<<" save-snapshot <file_name>                   : Save the catalog as a binary snapshot"<<endl
+		<<" load-snapshot <file_name>                   : Replace the catalog with a binary snapshot"<<endl
+		<<" checkpoint                                  : Rewrite the base snapshot and trim the journal"<<endl
 		<<" find <keyword>                              : List all books and categories containing the <keyword>"<<endl
-		<<" findAuthor <author name>                    : List all books whose author matches text"<<endl
+		<<" findAuthor <author name>                    : List all books whose author contains text (case-sensitive)"<<endl
+		<<" findAuthor --exact <author>                 : Books by exactly this author (ignores case/spacing)"<<endl
+		<<" findAuthor --prefix <start>                 : Books whose author starts with text (ignores case/spacing)"<<endl
 		<<" findBook <title of the book>                : Search a book in the catalog"<<endl
+		<<" findISBN <isbn>                             : Search a book by ISBN (ISBN-10 or ISBN-13)"<<endl
 		<<" findAll <category/sub-category/..>          : List all books in a category/sub-category"<<endl
+		<<" findYear <from>-<to> [category]             : List books published in a year range"<<endl
 		<<" addBook <book-title>                        : Add a book to the catalog"<<endl
 		<<" editBook <book-title>                       : Edit a book detail in the catalog"<<endl
 		<<" removeBook <book-title>                     : Remove a book from the catalog"<<endl
@@ -27,10 +34,42 @@ void listCommands()
 }
 //=======================================
 // main function
-int main()
+// Optional startup flags:
+//   --snapshot <file>   load this binary snapshot first (if it exists)
+//   --journal <file>    replay it on top of the snapshot and journal every change
+//   --unordered-books   removing a book moves its category's last book into the gap
+//                       (O(1) removal; a category's listing order changes after removals)
+int main(int argc, char** argv)
 {
+	string snapshotFile="";
+	string journalFile="";
+	bool unorderedBooks=false;
+	for(int i=1; i<argc; i++)
+	{
+		string arg=argv[i];
+		if(arg=="--snapshot" and i+1<argc)
+			snapshotFile=argv[++i];
+		else if(arg=="--journal" and i+1<argc)
+			journalFile=argv[++i];
+		else if(arg=="--unordered-books")
+			unorderedBooks=true;
+		else
+		{
+			cout<<"Usage: "<<argv[0]<<" [--snapshot <file> [--journal <file>]] [--unordered-books]"<<endl;
+			return EXIT_FAILURE;
+		}
+	}
+	// The journal continues from a base snapshot, so it needs one to name
+	if(journalFile!="" and snapshotFile=="")
+	{
+		cout<<"--journal requires --snapshot <file> (the file may not exist yet)"<<endl;
+		return EXIT_FAILURE;
+	}
 
 	LCMS lcms("Library");
+	lcms.setUnorderedBooks(unorderedBooks);
+	if(!lcms.openCatalog(snapshotFile,journalFile))
+		return EXIT_FAILURE;
 
 	listCommands();
 
@@ -43,7 +82,8 @@ int main()
 		try
 		{
 			cout<<"> ";
-			getline(cin,user_input);
+			if(!getline(cin,user_input))
+				break; // end of input behaves like exit
 			
 			// parse user-input into command and parameter(s)
 			stringstream sstr(user_input);
@@ -55,6 +95,12 @@ int main()
 			    lcms.import(parameter1); 
 			else if(command=="export")    	    							
 				lcms.exportData(parameter1);
+			else if(command=="save-snapshot")
+				lcms.saveSnapshot(parameter1);
+			else if(command=="load-snapshot")
+				lcms.loadSnapshot(parameter1);
+			else if(command=="checkpoint")
+				lcms.checkpoint();
 			else if(command=="list")										
 				lcms.list();
 			else if(command=="find") 						     			
@@ -63,6 +109,10 @@ int main()
 				lcms.findByAuthor(parameter1);
 			else if(command=="findBook" or command=="findbook" or command == "fb")				
 				lcms.findBook(parameter1);
+			else if(command=="findISBN" or command=="findisbn" or command == "fi")
+				lcms.findISBN(parameter1);
+			else if(command=="findYear" or command=="findyear" or command == "fy")
+				lcms.findYear(parameter1);
 			else if(command=="findAll" or command=="findall" or command == "fa")     			
 				lcms.findAll(parameter1);
 			else if(command=="addBook" or command=="addbook" or command == "ab") 				
@@ -84,6 +134,9 @@ int main()
 			else if(command == "exit" or command =="quit")										
 				break;
 			else cout<<"Invalid Command!"<<endl;
+
+			// Between commands the tree is stable: a good moment to start a checkpoint
+			lcms.maybeCheckpoint();
 			
 			fflush(stdin);
 			cin.clear();
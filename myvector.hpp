@@ -4,47 +4,118 @@
 //============================================================================
 // Name         : myvector.h
 // Author       : Omer Hayat
-// Version      : 1.3
+// Version      : 1.6
 // Date         : 11-11-2025
-// Date Modified: 11-11-2025 
+// Date Modified: 16-10-2026
 // Description  : Vector implementation in C++
 //============================================================================
 
 
 // -----------------------------------------------------------------------------
 // Library Catalog Project — MyVector (lightweight std::vector clone).
-// I manage a raw heap array, grow it on demand, and expose a small API
+// I manage a raw heap buffer, grow it on demand, and expose a small API
 // that’s enough for this assignment (push_back, insert/remove, bounds checks).
+// The buffer is uninitialized storage: only slots [0, size) hold live objects,
+// built with placement new and destroyed as soon as they leave the vector, so
+// a vector of Book* or string never pays for constructors of unused capacity.
+// SmallVector<T, N> (below) is a MyVector whose first N elements live inside
+// the object itself; it is passed around as a plain MyVector<T>&.
 // -----------------------------------------------------------------------------
 
 #include <iostream>    // not strictly required here, but handy for quick tests
 #include <cstdlib>     // general purpose (kept from starter)
+#include <cstddef>     // size_t sizes and indices
 #include <iomanip>     // kept from starter template
 #include <stdexcept>   // for std::out_of_range in at() and pop_back()
 #include <sstream>     // kept from starter template
-#include <algorithm>   // for std::max used in copy-ctor
+#include <algorithm>   // kept from starter template
+#include <iterator>    // std::distance / iterator_traits for iterator ranges
+#include <type_traits> // forward vs single-pass ranges in insert()
+#include <new>         // raw ::operator new + placement new
+#include <utility>     // std::move / std::forward for move-aware growth and emplace_back
 
 using namespace std;
 
+// -----------------------------------------------------------------------------
+// Growth policy. When full, capacity becomes capacity * MYVECTOR_GROWTH_FACTOR
+// (at least one more slot), and a vector's first buffer holds
+// MYVECTOR_MIN_CAPACITY elements. 1.5 keeps at most a third of the buffer idle
+// and lets freed blocks be reused by later growth; build with
+// -DMYVECTOR_GROWTH_FACTOR=2.0 to trade memory for fewer reallocations.
+// -----------------------------------------------------------------------------
+#ifndef MYVECTOR_GROWTH_FACTOR
+#define MYVECTOR_GROWTH_FACTOR 1.5
+#endif
+
+#ifndef MYVECTOR_MIN_CAPACITY
+#define MYVECTOR_MIN_CAPACITY 4
+#endif
+
 // -----------------------------------------------------------------------------
 // MyVector: behaves like a simplified vector<T>.
 // Owns a contiguous heap buffer and tracks logical size vs. capacity.
 // -----------------------------------------------------------------------------
 template <typename T>
-class MyVector 
+class MyVector
 {
 	private:
-		// Pointer to the contiguous storage I allocate with new[] / delete[].
+		// Raw storage from ::operator new; only the first v_size slots are constructed.
 	    T *array;
 
 		// Number of valid elements the user has pushed/inserted.
-	    int v_size;
+	    size_t v_size;
 
 		// Allocated slots available in 'array' (can be >= v_size).
-	    int v_capacity;
+	    size_t v_capacity;
+
+		// In-object storage of a SmallVector (nullptr for a plain MyVector).
+		// 'array' points here until the elements outgrow it; it is never freed.
+	    T *inlineBuffer;
+
+		// True while the elements sit in a SmallVector's in-object slots.
+	    bool onInlineStorage() const;
+
+		// Swap buffers with a vector that has no inline storage (neither side may have one).
+	    void swapHeap(MyVector<T>& other);
+
+		// Drop our elements and take other's heap buffer (other must not be on inline
+		// storage); other is left empty with no buffer. Never allocates or throws.
+	    void stealHeap(MyVector<T>& other);
+
+		// Replace our contents with other's, element by element (used when either side is small).
+	    void assignFrom(const MyVector<T>& other);
+	    void assignFrom(MyVector<T>&& other);
+
+		// Capacity to grow to when the buffer is full (growth factor, minimum size).
+	    size_t grownCapacity() const;
+
+		// Move the live elements into a fresh buffer of exactly newCapacity slots.
+	    void reallocate(size_t newCapacity);
+
+	protected:
+		// SmallVector: start out on the caller's inline storage of inlineCapacity slots.
+		MyVector(T* inlineStorage, size_t inlineCapacity);
+
+		// SmallVector: drop the elements and any heap buffer and go back to the
+		// inline slots (after being moved from, or to take inline contents without
+		// allocating). Never allocates or throws.
+		void returnToInline(size_t inlineCapacity) noexcept;
 
 	public:
-		// Default constructor: start with a tiny buffer and size 0.
+		// -----------------------------------------------------------------
+		// Iterators are plain pointers into the buffer, so MyVector works
+		// with std::sort, std::lower_bound, std::partition, ... directly.
+		// Any growth (push/insert past capacity, reserve) invalidates them.
+		// -----------------------------------------------------------------
+		typedef T value_type;
+		typedef T* iterator;
+		typedef const T* const_iterator;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+		typedef T& reference;
+		typedef const T& const_reference;
+
+		// Default constructor: size 0, no buffer until the first element arrives.
 		MyVector();
 
 		// Copy constructor: deep copy the contents (no sharing of the buffer).
@@ -53,41 +124,86 @@ class MyVector
 		// Copy assignment: copy-and-swap pattern for safety.
 		MyVector<T>& operator=(const MyVector<T>& other);
 
-		// Destructor: free the heap buffer and reset counters.
+		// Move constructor: steal other's heap buffer (other is left empty, no buffer).
+		// noexcept, so containers of vectors (MyVector<MyVector<...>>, std::
+		// containers) move them instead of copying when they grow. A source still
+		// on its inline slots is moved element by element into slots we already
+		// have (a SmallVector's own inline slots); element moves must not throw.
+		MyVector(MyVector<T>&& other) noexcept;
+
+		// Move assignment: same rule (heap buffer stolen, inline contents moved over).
+		MyVector<T>& operator=(MyVector<T>&& other) noexcept;
+
+		// Destructor: destroy the elements and free the heap buffer.
 		~MyVector();
 
 		// -----------------------------------------------------------------
 		// Size / capacity helpers — all O(1) and const (metadata only).
 		// -----------------------------------------------------------------
-		int size()     const;
-		int capacity() const;
-		bool empty()   const;
+		size_t size()     const;
+		size_t capacity() const;
+		bool empty()      const;
 
-		// clear() keeps the buffer but forgets the elements (v_size = 0).
+		// clear() destroys the elements but keeps the buffer (v_size = 0).
 		void clear();
 
 		// reserve() makes sure capacity is at least newCapacity (no shrink).
-		void reserve(int newCapacity);
+		void reserve(size_t newCapacity);
+
+		// shrink_to_fit() drops unused capacity (frees the buffer when empty).
+		void shrink_to_fit();
 
 		// -----------------------------------------------------------------
 		// Element access
 		// operator[] is unchecked (fast); at() is checked (throws).
 		// -----------------------------------------------------------------
-		T& operator[](int index);
-		const T& operator[](int index) const;
+		T& operator[](size_t index);
+		const T& operator[](size_t index) const;
+
+		T& at(size_t index);
+		const T& at(size_t index) const;
 
-		T& at(int index);
-		const T& at(int index) const;
+		// Contiguous storage (may be nullptr while the vector has no buffer)
+		T* data();
+		const T* data() const;
+
+		iterator begin();
+		iterator end();
+		const_iterator begin() const;
+		const_iterator end() const;
+		const_iterator cbegin() const;
+		const_iterator cend() const;
 
 		// -----------------------------------------------------------------
 		// Modifiers
-		// push_back appends; insertAt shifts right; removeAt shifts left; 
-		// pop_back just reduces v_size by 1 (with underflow guard).
+		// push_back appends; insertAt shifts right; removeAt shifts left;
+		// pop_back moves the last element out and returns it (with underflow guard);
+		// swap_remove fills the hole with the last element (O(1), order not kept).
+		// Elements are moved (not copied) when the buffer grows or shifts.
 		// -----------------------------------------------------------------
 		void push_back(const T& value);
-		void insertAt(int index, const T& value);
-		void removeAt(int index);
-		void pop_back();
+		void push_back(T&& value);
+		template <typename... Args>
+		void emplace_back(Args&&... args);
+		void insertAt(size_t index, const T& value);
+		void removeAt(size_t index);
+		void swap_remove(size_t index);
+		T pop_back();
+
+		// Last element (unchecked, like operator[]; the vector must not be empty)
+		T& back();
+		const T& back() const;
+
+		// Range forms: insert copies [first, last) before 'pos' (the range may
+		// come from this vector); erase removes [first, last) and closes the gap.
+		// Both return an iterator to the first inserted / following element.
+		template <typename It>
+		iterator insert(const_iterator pos, It first, It last);
+		iterator erase(const_iterator first, const_iterator last);
+		iterator erase(const_iterator pos);
+
+		// Exchange contents with another vector (O(1) unless either side is small)
+		void swap(MyVector<T>& other);
 
 		// -----------------------------------------------------------------
 		// Search helper: linear scan for the first equal element.
@@ -99,35 +215,98 @@ class MyVector
 // Implementation
 // ============================================================================
 
+// -----------------------------------------------------------------------------
+// grownCapacity:
+// - First buffer: MYVECTOR_MIN_CAPACITY slots
+// - After that: capacity * MYVECTOR_GROWTH_FACTOR, but always at least +1
+// -----------------------------------------------------------------------------
+template <typename T>
+size_t MyVector<T>::grownCapacity() const {
+	if (v_capacity < MYVECTOR_MIN_CAPACITY) return MYVECTOR_MIN_CAPACITY;
+	size_t grown = (size_t)(v_capacity * MYVECTOR_GROWTH_FACTOR);
+	return grown > v_capacity ? grown : v_capacity + 1;
+}
+
+// -----------------------------------------------------------------------------
+// reallocate(newCapacity):
+// - Caller guarantees newCapacity >= v_size
+// - Move-construct each element into the new buffer (copy if T's move
+//   could throw), destroy the old ones, free the old buffer
+// -----------------------------------------------------------------------------
+template <typename T>
+void MyVector<T>::reallocate(size_t newCapacity) {
+	T* new_array = nullptr;
+	if (newCapacity > 0) {
+		new_array = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+	}
+
+	size_t built = 0;
+	try {
+		for (; built < v_size; built++){
+			new (new_array + built) T(std::move_if_noexcept(array[built]));
+		}
+	} catch (...) {
+		for (size_t i = 0; i < built; i++) new_array[i].~T();
+		::operator delete(new_array);
+		throw;
+	}
+
+	for (size_t i = 0; i < v_size; i++) array[i].~T();
+	if (array != inlineBuffer) ::operator delete(array);
+	array = new_array;
+	v_capacity = newCapacity;
+}
+
 // -----------------------------------------------------------------------------
 // Default constructor:
-// - Start empty (v_size = 0)
-// - Give a tiny starting capacity (2) so the first couple pushes are cheap
-// - Allocate the backing array
+// - Start empty (v_size = 0) with no buffer at all; many vectors (a leaf
+//   category's children, most posting lists) never get an element, and the
+//   first push allocates MYVECTOR_MIN_CAPACITY slots at once
 // -----------------------------------------------------------------------------
 template <typename T>
 MyVector<T>::MyVector(){
+	array = nullptr;
 	v_size = 0;
-	v_capacity = 2;
-	array = new T[v_capacity];
+	v_capacity = 0;
+	inlineBuffer = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// Inline-storage constructor (SmallVector only):
+// - The first inlineCapacity elements go into the derived object's own bytes
+// -----------------------------------------------------------------------------
+template <typename T>
+MyVector<T>::MyVector(T* inlineStorage, size_t inlineCapacity){
+	array = inlineStorage;
+	v_size = 0;
+	v_capacity = inlineCapacity;
+	inlineBuffer = inlineStorage;
 }
 
 // -----------------------------------------------------------------------------
 // Copy constructor:
-// - Take over other's logical size
-// - Allocate our own buffer (at least 2)
-// - Copy elements one-by-one into our storage
+// - Allocate exactly other's size (a copy does not inherit spare capacity)
+// - Copy-construct elements one-by-one into our storage
 // -----------------------------------------------------------------------------
 template <typename T>
 MyVector<T>::MyVector(const MyVector<T>& other) {
-	v_size = other.v_size;
-	v_capacity = max(other.v_capacity, 2);
-
-	T* new_array = new T[v_capacity];
-	for (int i = 0; i < v_size; i++) {
-		new_array[i] = other.array[i];
+	array = nullptr;
+	v_size = 0;
+	v_capacity = 0;
+	inlineBuffer = nullptr;
+	if (other.v_size == 0) return;
+
+	array = static_cast<T*>(::operator new(other.v_size * sizeof(T)));
+	v_capacity = other.v_size;
+	try {
+		for (; v_size < other.v_size; v_size++) {
+			new (array + v_size) T(other.array[v_size]);
+		}
+	} catch (...) {
+		for (size_t i = 0; i < v_size; i++) array[i].~T();
+		::operator delete(array);
+		throw;
 	}
-	array = new_array;
 }
 
 // -----------------------------------------------------------------------------
@@ -141,35 +320,143 @@ template <typename T>
 MyVector<T>& MyVector<T>::operator=(const MyVector<T>& other) {
 	if (this == &other) return *this;
 
+	if (inlineBuffer != nullptr) {
+		assignFrom(other); // our buffer may be in-object: it cannot change hands
+		return *this;
+	}
 	MyVector<T> tmp(other);
+	swapHeap(tmp);
+	return *this;
+}
+
+// -----------------------------------------------------------------------------
+// onInlineStorage: a SmallVector that has not spilled onto the heap yet
+// -----------------------------------------------------------------------------
+template <typename T>
+bool MyVector<T>::onInlineStorage() const {
+	return inlineBuffer != nullptr && array == inlineBuffer;
+}
 
+// -----------------------------------------------------------------------------
+// swapHeap(other):
+// - Exchange buffers and counters; only legal when neither side is small
+// -----------------------------------------------------------------------------
+template <typename T>
+void MyVector<T>::swapHeap(MyVector<T>& other) {
 	T* tmpArr = array;
-	array = tmp.array;
-	tmp.array = tmpArr;
+	array = other.array;
+	other.array = tmpArr;
+
+	size_t tmpSize = v_size;
+	v_size = other.v_size;
+	other.v_size = tmpSize;
+
+	size_t tmpCapacity = v_capacity;
+	v_capacity = other.v_capacity;
+	other.v_capacity = tmpCapacity;
+}
+
+// -----------------------------------------------------------------------------
+// stealHeap(other):
+// - Destroy our elements and free our heap buffer (inline slots just go unused)
+// - Take other's buffer and counters; other keeps no buffer at all, so a
+//   spilled SmallVector that is refilled later grows on the heap
+// -----------------------------------------------------------------------------
+template <typename T>
+void MyVector<T>::stealHeap(MyVector<T>& other) {
+	clear();
+	if (array != inlineBuffer) ::operator delete(array);
+	array = other.array;
+	v_size = other.v_size;
+	v_capacity = other.v_capacity;
+	other.array = nullptr;
+	other.v_size = 0;
+	other.v_capacity = 0;
+}
 
-	int tmpSize = v_size;
-	v_size = tmp.v_size;
-	tmp.v_size = tmpSize;
+// -----------------------------------------------------------------------------
+// assignFrom(other):
+// - Element-wise replace, keeping our own buffer (grown if needed)
+// - The rvalue version moves the elements and leaves other empty
+// -----------------------------------------------------------------------------
+template <typename T>
+void MyVector<T>::assignFrom(const MyVector<T>& other) {
+	clear();
+	reserve(other.v_size);
+	for (size_t i = 0; i < other.v_size; i++) new (array + i) T(other.array[i]);
+	v_size = other.v_size;
+}
 
-	int tmpCapacity = v_capacity;
-	v_capacity = tmp.v_capacity;
-	tmp.v_capacity = tmpCapacity;
+template <typename T>
+void MyVector<T>::assignFrom(MyVector<T>&& other) {
+	clear();
+	reserve(other.v_size);
+	for (size_t i = 0; i < other.v_size; i++) new (array + i) T(std::move(other.array[i]));
+	v_size = other.v_size;
+	other.clear();
+}
 
+// -----------------------------------------------------------------------------
+// returnToInline: back onto a SmallVector's in-object slots, empty
+// -----------------------------------------------------------------------------
+template <typename T>
+void MyVector<T>::returnToInline(size_t inlineCapacity) noexcept {
+	clear();
+	if (array != inlineBuffer) ::operator delete(array);
+	array = inlineBuffer;
+	v_capacity = inlineCapacity;
+}
+
+// -----------------------------------------------------------------------------
+// Move constructor:
+// - Take other's heap buffer and counters as-is (no element is touched)
+// - Leave other empty with no buffer; the next push gives it a fresh one
+// - Only a SmallVector still on its inline slots is moved element by element
+//   (those slots cannot change hands). SmallVector's own moves land them in
+//   its inline slots; only a plain MyVector taking them over through a
+//   MyVector<T>& needs a buffer for them (at most N small elements)
+// -----------------------------------------------------------------------------
+template <typename T>
+MyVector<T>::MyVector(MyVector<T>&& other) noexcept {
+	array = nullptr;
+	v_size = 0;
+	v_capacity = 0;
+	inlineBuffer = nullptr;
+	if (other.onInlineStorage()) {
+		assignFrom(std::move(other));
+		return;
+	}
+	stealHeap(other);
+}
+
+// -----------------------------------------------------------------------------
+// Move assignment:
+// - Heap source (plain or spilled small): drop our elements, take its buffer
+//   (O(1), no allocation, even when we are a SmallVector ourselves)
+// - Source on inline slots: move the elements into our own storage instead
+// -----------------------------------------------------------------------------
+template <typename T>
+MyVector<T>& MyVector<T>::operator=(MyVector<T>&& other) noexcept {
+	if (this == &other) return *this;
+
+	if (other.onInlineStorage()) {
+		assignFrom(std::move(other));
+		return *this;
+	}
+	stealHeap(other);
 	return *this;
 }
 
 // -----------------------------------------------------------------------------
 // Destructor:
-// - Match new[] with delete[]
+// - Destroy the live elements, then release the raw buffer
 // - Null the pointer and zero the counters (defensive cleanup)
 // -----------------------------------------------------------------------------
 template <typename T>
 MyVector<T>::~MyVector(){
-	if (array != nullptr){
-		delete [] array;
-		array = nullptr;
-	}
-	v_size = 0;
+	clear();
+	if (array != inlineBuffer) ::operator delete(array);
+	array = nullptr;
 	v_capacity = 0;
 }
 
@@ -177,55 +464,60 @@ MyVector<T>::~MyVector(){
 // size/capacity/empty: quick metadata accessors (const and O(1)).
 // -----------------------------------------------------------------------------
 template <typename T>
-int MyVector<T>::size() const { return v_size; }
+size_t MyVector<T>::size() const { return v_size; }
 
 template <typename T>
-int MyVector<T>::capacity() const { return v_capacity; }
+size_t MyVector<T>::capacity() const { return v_capacity; }
 
 template <typename T>
 bool MyVector<T>::empty() const { return v_size == 0; }
 
 // -----------------------------------------------------------------------------
 // clear:
-// - Do not free memory; just forget the elements
-// - Next pushes will overwrite previous contents
+// - Destroy every element (strings give their memory back right away)
+// - Keep the buffer, so refilling the vector does not reallocate
 // -----------------------------------------------------------------------------
 template <typename T>
 void MyVector<T>::clear() {
+	for (size_t i = 0; i < v_size; i++) array[i].~T();
 	v_size = 0;
 }
 
 // -----------------------------------------------------------------------------
 // reserve(newCapacity):
 // - Only grows (never shrinks here)
-// - Allocate new buffer, copy current elements, free old buffer, update state
+// - Move the elements into an exactly-sized new buffer
 // -----------------------------------------------------------------------------
 template <typename T>
-void MyVector<T>::reserve(int newCapacity) {
+void MyVector<T>::reserve(size_t newCapacity) {
 	if (newCapacity <= v_capacity) return;
+	reallocate(newCapacity);
+}
 
-	T* new_array = new T[newCapacity];
-	for (int i = 0; i < v_size; i++){
-		new_array[i] = array[i];
-	}
-
-	delete [] array;
-	array = new_array;
-	v_capacity = newCapacity;
+// -----------------------------------------------------------------------------
+// shrink_to_fit:
+// - Give back the unused tail (e.g. after a big removeCategory / compact)
+// - An empty vector frees its buffer entirely
+// - Inline storage is part of the object, so there is nothing to give back
+// -----------------------------------------------------------------------------
+template <typename T>
+void MyVector<T>::shrink_to_fit() {
+	if (v_capacity == v_size || array == inlineBuffer) return;
+	reallocate(v_size);
 }
 
 // -----------------------------------------------------------------------------
 // operator[] (unchecked):
-// - Caller must ensure 0 <= index < v_size
+// - Caller must ensure index < v_size
 // - Useful in tight loops when you already know bounds are valid
 // -----------------------------------------------------------------------------
 template <typename T>
-T& MyVector<T>::operator[](int index){
+T& MyVector<T>::operator[](size_t index){
 	return array[index];
 }
 
 template <typename T>
-const T& MyVector<T>::operator[](int index) const {
+const T& MyVector<T>::operator[](size_t index) const {
     return array[index];
 }
 
@@ -235,16 +527,16 @@ const T& MyVector<T>::operator[](int index) const {
 // - Safer when handling user-provided indices
 // -----------------------------------------------------------------------------
 template <typename T>
-T& MyVector<T>::at(int index) {
-	if (index < 0 || index >= v_size){
+T& MyVector<T>::at(size_t index) {
+	if (index >= v_size){
 		throw out_of_range("Index out of range");
 	}
 	return array[index];
 }
 
 template <typename T>
-const T& MyVector<T>::at(int index) const {
-	if (index < 0 || index >= v_size){
+const T& MyVector<T>::at(size_t index) const {
+	if (index >= v_size){
 		throw out_of_range("Index out of range");
 	}
 	return array[index];
@@ -252,67 +544,267 @@ const T& MyVector<T>::at(int index) const {
 
 // -----------------------------------------------------------------------------
 // push_back(value):
-// - Grow when full (double capacity)
-// - Write at the end and bump v_size
+// - Grow when full (see grownCapacity)
+// - Construct the copy in the first free slot and bump v_size
+// - 'value' may be one of our own elements, so copy it before growing
+//   (growth moves the elements and frees the old buffer)
 // -----------------------------------------------------------------------------
 template <typename T>
 void MyVector<T>::push_back(const T& value){
 	if (v_size == v_capacity){
-		reserve(v_capacity * 2);
+		T copy(value);
+		reallocate(grownCapacity());
+		new (array + v_size) T(std::move(copy));
+	} else {
+		new (array + v_size) T(value);
+	}
+	v_size++;
+}
+
+// -----------------------------------------------------------------------------
+// push_back(rvalue):
+// - Same as above, but the value's contents are moved in (no deep copy)
+// -----------------------------------------------------------------------------
+template <typename T>
+void MyVector<T>::push_back(T&& value){
+	if (v_size == v_capacity){
+		T moved(std::move(value));
+		reallocate(grownCapacity());
+		new (array + v_size) T(std::move(moved));
+	} else {
+		new (array + v_size) T(std::move(value));
+	}
+	v_size++;
+}
+
+// -----------------------------------------------------------------------------
+// emplace_back(args...):
+// - Construct the element directly in its slot from constructor arguments
+// - Arguments may refer to our own elements, so when growing, build the
+//   element first and move it in
+// -----------------------------------------------------------------------------
+template <typename T>
+template <typename... Args>
+void MyVector<T>::emplace_back(Args&&... args){
+	if (v_size == v_capacity){
+		T built(std::forward<Args>(args)...);
+		reallocate(grownCapacity());
+		new (array + v_size) T(std::move(built));
+	} else {
+		new (array + v_size) T(std::forward<Args>(args)...);
 	}
-	array[v_size] = value;
 	v_size++;
 }
 
 // -----------------------------------------------------------------------------
 // insertAt(index, value):
 // - Valid indices are [0..v_size] (inserting at v_size == append)
-// - Make room by shifting elements to the right
+// - Make room by moving elements to the right (the last one is
+//   move-constructed into the uninitialized slot past the end)
+// - 'value' may be one of our own elements, so take a copy before shifting
 // -----------------------------------------------------------------------------
 template <typename T>
-void MyVector<T>::insertAt(int index, const T& value) {
-	if (index < 0 || index > v_size){
+void MyVector<T>::insertAt(size_t index, const T& value) {
+	if (index > v_size){
 		throw out_of_range("Index is out of range");
 	}
+	if (index == v_size){
+		push_back(value);
+		return;
+	}
 
+	T copy(value);
 	if (v_size == v_capacity){
-		reserve(v_capacity * 2);
+		reallocate(grownCapacity());
 	}
 
-	for (int i = v_size - 1; i >= index; i--){
-		array[i+1] = array[i];
+	new (array + v_size) T(std::move(array[v_size - 1]));
+	for (size_t i = v_size - 1; i > index; i--){
+		array[i] = std::move(array[i-1]);
 	}
-	array[index] = value;
+	array[index] = std::move(copy);
 	v_size++;
 }
 
 // -----------------------------------------------------------------------------
 // removeAt(index):
 // - Valid indices are [0..v_size-1]
-// - Close the hole by shifting elements left
+// - Close the hole by moving elements left, then destroy the stale last slot
 // -----------------------------------------------------------------------------
 template <typename T>
-void MyVector<T>::removeAt(int index){
-	if (index < 0 || index >= v_size){
+void MyVector<T>::removeAt(size_t index){
+	if (index >= v_size){
 		throw out_of_range("Index is out of range");
 	}
 
-	for (int i = index; i < v_size - 1; i++){
-		array[i] = array[i+1];
+	for (size_t i = index; i + 1 < v_size; i++){
+		array[i] = std::move(array[i+1]);
+	}
+	v_size--;
+	array[v_size].~T();
+}
+
+// -----------------------------------------------------------------------------
+// swap_remove(index):
+// - Valid indices are [0..v_size-1]
+// - Move the last element into the hole and destroy the old last slot:
+//   O(1) no matter how long the vector is, but the order is not preserved
+// -----------------------------------------------------------------------------
+template <typename T>
+void MyVector<T>::swap_remove(size_t index){
+	if (index >= v_size){
+		throw out_of_range("Index is out of range");
 	}
-	v_size--;	
+
+	v_size--;
+	if (index != v_size) array[index] = std::move(array[v_size]);
+	array[v_size].~T();
 }
 
 // -----------------------------------------------------------------------------
 // pop_back():
-// - Underflow-guarded decrement of v_size (no return value)
+// - Underflow-guarded; moves the last element out, destroys its slot and
+//   returns it, so a DFS loop can write 'Node* cur = stack.pop_back();'
 // -----------------------------------------------------------------------------
 template <typename T>
-void MyVector<T>::pop_back(){
+T MyVector<T>::pop_back(){
 	if (v_size == 0){
 		throw out_of_range("Vector is empty");
 	}
 	v_size--;
+	T last(std::move(array[v_size]));
+	array[v_size].~T();
+	return last;
+}
+
+// -----------------------------------------------------------------------------
+// back(): the last element (caller ensures the vector is not empty)
+// -----------------------------------------------------------------------------
+template <typename T>
+T& MyVector<T>::back(){
+	return array[v_size - 1];
+}
+
+template <typename T>
+const T& MyVector<T>::back() const {
+	return array[v_size - 1];
+}
+
+// -----------------------------------------------------------------------------
+// data / begin / end: raw pointers into the live range [0, v_size)
+// -----------------------------------------------------------------------------
+template <typename T>
+T* MyVector<T>::data() { return array; }
+
+template <typename T>
+const T* MyVector<T>::data() const { return array; }
+
+template <typename T>
+typename MyVector<T>::iterator MyVector<T>::begin() { return array; }
+
+template <typename T>
+typename MyVector<T>::iterator MyVector<T>::end() { return array + v_size; }
+
+template <typename T>
+typename MyVector<T>::const_iterator MyVector<T>::begin() const { return array; }
+
+template <typename T>
+typename MyVector<T>::const_iterator MyVector<T>::end() const { return array + v_size; }
+
+template <typename T>
+typename MyVector<T>::const_iterator MyVector<T>::cbegin() const { return array; }
+
+template <typename T>
+typename MyVector<T>::const_iterator MyVector<T>::cend() const { return array + v_size; }
+
+// -----------------------------------------------------------------------------
+// insert(pos, first, last):
+// - Stage the incoming elements first (the range may point into this vector,
+//   and growth would free it), grow once, then open a gap of n slots
+// - Slots past the old end are raw memory: construct there, assign elsewhere
+// -----------------------------------------------------------------------------
+template <typename T>
+template <typename It>
+typename MyVector<T>::iterator MyVector<T>::insert(const_iterator pos, It first, It last) {
+	size_t index = (size_t)(pos - array);
+	if (index > v_size){
+		throw out_of_range("Index is out of range");
+	}
+
+	MyVector<T> incoming;
+	typedef typename std::iterator_traits<It>::iterator_category Category;
+	if (std::is_base_of<std::forward_iterator_tag, Category>::value){
+		incoming.reserve((size_t)std::distance(first, last)); // multi-pass: size it once
+	}
+	for (; first != last; ++first) incoming.push_back(*first);
+	size_t n = incoming.v_size;
+	if (n == 0) return array + index;
+
+	if (v_size + n > v_capacity){
+		size_t grown = grownCapacity();
+		reallocate(grown > v_size + n ? grown : v_size + n);
+	}
+
+	for (size_t i = v_size; i-- > index; ){
+		if (i + n >= v_size) new (array + i + n) T(std::move(array[i]));
+		else array[i + n] = std::move(array[i]);
+	}
+	for (size_t k = 0; k < n; k++){
+		if (index + k >= v_size) new (array + index + k) T(std::move(incoming.array[k]));
+		else array[index + k] = std::move(incoming.array[k]);
+	}
+	v_size += n;
+	return array + index;
+}
+
+// -----------------------------------------------------------------------------
+// erase(first, last):
+// - Move the tail left over the erased range, then destroy the stale tail
+// -----------------------------------------------------------------------------
+template <typename T>
+typename MyVector<T>::iterator MyVector<T>::erase(const_iterator first, const_iterator last) {
+	size_t from = (size_t)(first - array);
+	size_t to = (size_t)(last - array);
+	if (from > to || to > v_size){
+		throw out_of_range("Index is out of range");
+	}
+
+	size_t n = to - from;
+	if (n == 0) return array + from;
+	for (size_t i = to; i < v_size; i++){
+		array[i - n] = std::move(array[i]);
+	}
+	for (size_t i = v_size - n; i < v_size; i++) array[i].~T();
+	v_size -= n;
+	return array + from;
+}
+
+template <typename T>
+typename MyVector<T>::iterator MyVector<T>::erase(const_iterator pos) {
+	return erase(pos, pos + 1);
+}
+
+// -----------------------------------------------------------------------------
+// swap(other):
+// - Plain vectors trade buffers; otherwise the contents go through a temporary
+//   (heap buffers are still handed over; only inline contents are moved)
+// -----------------------------------------------------------------------------
+template <typename T>
+void MyVector<T>::swap(MyVector<T>& other) {
+	if (this == &other) return;
+	if (inlineBuffer == nullptr && other.inlineBuffer == nullptr){
+		swapHeap(other);
+		return;
+	}
+	MyVector<T> tmp(std::move(*this));
+	*this = std::move(other);
+	other = std::move(tmp);
+}
+
+// Non-member swap so std algorithms and 'using std::swap' find the fast one
+template <typename T>
+void swap(MyVector<T>& a, MyVector<T>& b) {
+	a.swap(b);
 }
 
 // -----------------------------------------------------------------------------
@@ -322,12 +814,73 @@ void MyVector<T>::pop_back(){
 // -----------------------------------------------------------------------------
 template <typename T>
 int MyVector<T>::indexOf(const T& value) const {
-	for (int i = 0; i < v_size; i++) {
-		if (array[i] == value) return i;
+	for (size_t i = 0; i < v_size; i++) {
+		if (array[i] == value) return (int)i;
 	}
 	return -1;
 }
 
+// -----------------------------------------------------------------------------
+// SmallVector<T, N>: a MyVector with room for N elements inside the object.
+// Up to N elements cost no heap allocation at all; past that it grows onto
+// the heap like any MyVector. It *is* a MyVector<T>, so code that takes a
+// MyVector<T>& works on it unchanged. Suited to the many small lists that
+// sit in objects (a category's children and books).
+// -----------------------------------------------------------------------------
+template <typename T, size_t N>
+class SmallVector : public MyVector<T>
+{
+	private:
+		// In-object slots; raw bytes until MyVector constructs elements there.
+	    alignas(T) unsigned char storage[N * sizeof(T)];
+
+	public:
+		SmallVector();
+		SmallVector(const SmallVector<T, N>& other);
+		SmallVector<T, N>& operator=(const SmallVector<T, N>& other);
+		SmallVector(SmallVector<T, N>&& other) noexcept;
+		SmallVector<T, N>& operator=(SmallVector<T, N>&& other) noexcept;
+
+		// Destroys the elements while 'storage' is still alive
+		~SmallVector();
+};
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector() : MyVector<T>(reinterpret_cast<T*>(storage), N) {}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector<T, N>& other) : MyVector<T>(reinterpret_cast<T*>(storage), N) {
+	MyVector<T>::operator=(other);
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(const SmallVector<T, N>& other) {
+	MyVector<T>::operator=(other);
+	return *this;
+}
+
+// Moves never allocate: inline contents land in our (empty) inline slots, a heap
+// buffer changes hands, and the source goes back to its own inline slots
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(SmallVector<T, N>&& other) noexcept : MyVector<T>(reinterpret_cast<T*>(storage), N) {
+	MyVector<T>::operator=(std::move(other));
+	other.returnToInline(N);
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(SmallVector<T, N>&& other) noexcept {
+	if (this == &other) return *this;
+	if (other.size() > this->capacity()) this->returnToInline(N); // other is on the heap or fits in N
+	MyVector<T>::operator=(std::move(other));
+	other.returnToInline(N);
+	return *this;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::~SmallVector() {
+	this->clear();
+}
+
 // -----------------------------------------------------------------------------
 // Guard line from the starter: don’t append code below this point.
 // -----------------------------------------------------------------------------
@@ -0,0 +1,240 @@
+#ifndef _SLAB_H
+#define _SLAB_H
+
+// -----------------------------------------------------------------------------
+// Library Catalog Project — SlabPool (pooled storage for Node / Book objects).
+// A big catalog is millions of small objects; allocating each with new and
+// freeing each with delete costs a malloc/free per object, scatters them
+// across the heap and makes tearing a catalog down slow. The Tree takes its
+// Nodes and Books from one SlabPool each instead:
+//   - slots are carved from large slabs (64 slots first, doubling up to 64K),
+//   - destroy() runs the destructor and threads the slot onto its slab's free
+//     list (no free() call), and create() reuses freed slots first,
+//   - every slab counts its live objects: releaseEmptySlabs() hands slabs
+//     that no longer hold anything back to the heap (the Tree calls it after
+//     removing a category, so a big removal gives its memory back mid-session),
+//   - the remaining slabs go back to the heap in one pass when the pool dies.
+// Objects of one subtree share slabs with the rest of the catalog (they were
+// created in import order), so only the slabs a removal empties completely
+// are returned; freed slots in shared slabs wait for the next insert.
+// The pool never runs destructors on its own: the owner destroys every live
+// object first (Tree walks the hierarchy), then lets the slabs go.
+// I use inline functions so that the function definitions inside the header file don’t cause linker errors when the header is included in multiple source files
+// Source: https://stackoverflow.com/questions/5057021/why-do-inline-functions-have-to-be-defined-in-a-header-file
+// -----------------------------------------------------------------------------
+
+#include <new>            // placement new
+#include <utility>        // std::forward
+#include <functional>     // std::less: a total order on slab addresses
+#include "myvector.hpp"   // list of slabs
+
+template <typename T>
+class SlabPool
+{
+	private:
+		// A slot holds either a live T or, once freed, the next free slot
+		union Slot
+		{
+			Slot* next;
+			alignas(T) unsigned char storage[sizeof(T)];
+		};
+
+		// One block of slots with its own free list and live count
+		struct Slab
+		{
+			Slot* slots;
+			int size;       // slots in this slab
+			int used;       // slots handed out at least once (bump pointer)
+			int live;       // objects currently constructed here
+			Slot* freeList; // destroyed slots, reused first
+			bool open;      // listed in openSlabs (has room)
+		};
+
+		static const int FIRST_SLAB = 64;
+		static const int MAX_SLAB = 65536;
+
+		MyVector<Slab*> slabs;      // sorted by address, to find an object's slab
+		MyVector<Slab*> openSlabs;  // slabs with a free or unused slot
+		int nextSlabSize;           // slots in the next slab opened
+		int live;                   // objects currently constructed (all slabs)
+
+		// Allocate a new slab and list it as open
+		Slab* openSlab();
+
+		// The slab holding 'slot' (binary search over the sorted slabs)
+		Slab* ownerOf(const Slot* slot) const;
+
+		// Take / give back one slot of 'slab', keeping its counts and open flag current
+		Slot* takeSlot(Slab* slab);
+		void returnSlot(Slab* slab, Slot* slot);
+
+	public:
+		SlabPool();
+		~SlabPool();
+
+		SlabPool(const SlabPool&) = delete;
+		SlabPool& operator=(const SlabPool&) = delete;
+
+		// Construct a T in a pooled slot
+		template <typename... Args>
+		T* create(Args&&... args);
+
+		// Destroy an object made by create() and recycle its slot
+		void destroy(T* object);
+
+		// Return every slab without a live object to the heap; returns how many
+		int releaseEmptySlabs();
+
+		// Objects created and not yet destroyed
+		int liveCount() const;
+
+		// Slabs currently held
+		int slabCount() const;
+};
+
+// ============================================================================
+// SlabPool methods
+// ============================================================================
+
+template <typename T>
+inline SlabPool<T>::SlabPool() {
+	nextSlabSize = FIRST_SLAB;
+	live = 0;
+}
+
+// Objects must already be destroyed; this only hands the slabs back
+template <typename T>
+inline SlabPool<T>::~SlabPool() {
+	for (size_t i = 0; i < slabs.size(); ++i) {
+		delete [] slabs[i]->slots;
+		delete slabs[i];
+	}
+}
+
+// Slabs double up to MAX_SLAB; the new one goes into its address-sorted place
+template <typename T>
+inline typename SlabPool<T>::Slab* SlabPool<T>::openSlab() {
+	Slab* slab = new Slab();
+	slab->slots = new Slot[nextSlabSize];
+	slab->size = nextSlabSize;
+	slab->used = 0;
+	slab->live = 0;
+	slab->freeList = nullptr;
+	slab->open = true;
+	nextSlabSize = (nextSlabSize < MAX_SLAB) ? nextSlabSize * 2 : MAX_SLAB;
+
+	std::less<const Slot*> before;
+	size_t at = slabs.size();
+	while (at > 0 && before(slab->slots, slabs[at - 1]->slots)) at--;
+	slabs.insertAt(at, slab);
+	openSlabs.push_back(slab);
+	return slab;
+}
+
+// Last slab starting at or before 'slot'
+template <typename T>
+inline typename SlabPool<T>::Slab* SlabPool<T>::ownerOf(const Slot* slot) const {
+	std::less<const Slot*> before;
+	size_t lo = 0, hi = slabs.size();
+	while (hi - lo > 1) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (before(slot, slabs[mid]->slots)) hi = mid;
+		else lo = mid;
+	}
+	return slabs[lo];
+}
+
+// Recycled slot first, else the next unused one; a full slab leaves the open list
+template <typename T>
+inline typename SlabPool<T>::Slot* SlabPool<T>::takeSlot(Slab* slab) {
+	Slot* slot;
+	if (slab->freeList != nullptr) {
+		slot = slab->freeList;
+		slab->freeList = slot->next;
+	} else {
+		slot = &slab->slots[slab->used++];
+	}
+	slab->live++;
+	live++;
+	if (slab->freeList == nullptr && slab->used == slab->size) {
+		slab->open = false;
+		openSlabs.pop_back(); // takeSlot is only called on openSlabs' last slab
+	}
+	return slot;
+}
+
+template <typename T>
+inline void SlabPool<T>::returnSlot(Slab* slab, Slot* slot) {
+	slot->next = slab->freeList;
+	slab->freeList = slot;
+	slab->live--;
+	live--;
+	if (!slab->open) {
+		slab->open = true;
+		openSlabs.push_back(slab);
+	}
+}
+
+template <typename T>
+template <typename... Args>
+inline T* SlabPool<T>::create(Args&&... args) {
+	Slab* slab = openSlabs.empty() ? openSlab() : openSlabs.back();
+	Slot* slot = takeSlot(slab);
+	T* object;
+	try {
+		object = new (slot->storage) T(std::forward<Args>(args)...);
+	} catch (...) {
+		returnSlot(slab, slot);
+		throw;
+	}
+	return object;
+}
+
+template <typename T>
+inline void SlabPool<T>::destroy(T* object) {
+	if (object == nullptr) return;
+	Slot* slot = reinterpret_cast<Slot*>(object);
+	Slab* slab = ownerOf(slot);
+	object->~T();
+	returnSlot(slab, slot);
+}
+
+// Two filtering passes over the (short) slab lists; an emptied pool starts small again
+template <typename T>
+inline int SlabPool<T>::releaseEmptySlabs() {
+	int released = 0;
+	size_t kept = 0;
+	for (size_t i = 0; i < openSlabs.size(); ++i) {
+		if (openSlabs[i]->live > 0) openSlabs[kept++] = openSlabs[i];
+	}
+	openSlabs.erase(openSlabs.begin() + kept, openSlabs.end());
+
+	kept = 0;
+	for (size_t i = 0; i < slabs.size(); ++i) {
+		if (slabs[i]->live > 0) {
+			slabs[kept++] = slabs[i];
+			continue;
+		}
+		delete [] slabs[i]->slots;
+		delete slabs[i];
+		released++;
+	}
+	slabs.erase(slabs.begin() + kept, slabs.end());
+	if (slabs.empty()) nextSlabSize = FIRST_SLAB;
+	return released;
+}
+
+template <typename T>
+inline int SlabPool<T>::liveCount() const {
+	return live;
+}
+
+template <typename T>
+inline int SlabPool<T>::slabCount() const {
+	return (int)slabs.size();
+}
+
+// -----------------------------------------------------------------------------
+// End guard: keep headers clean and avoid accidental extra code below.
+// -----------------------------------------------------------------------------
+#endif
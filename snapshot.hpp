@@ -0,0 +1,310 @@
+#ifndef _SNAPSHOT_H
+#define _SNAPSHOT_H
+
+// -----------------------------------------------------------------------------
+// Library Catalog Project — Binary catalog snapshots.
+// A snapshot is a flat image of the Tree that loads without any CSV work:
+//
+//   SnapshotHeader                      fixed size, magic + counts
+//   uint64 stringOffsets[strings + 1]   start of each string in the blob
+//   SnapshotNode  nodes[nodeCount]      preorder; parent index < own index
+//   SnapshotBook  books[bookCount]      grouped by node, in node order
+//   char          strings[stringBytes]  deduplicated names/fields, no separators
+//
+// Every number is stored in the writer's native byte order; the header keeps
+// a byte-order tag so a snapshot from a different-endian machine is refused.
+// The header also records the last journal sequence number the image already
+// contains, so replay on startup can skip those records (see journal.hpp).
+// Loading maps the file and walks the tables once; there is no text parsing.
+// I use inline functions so that the function definitions inside the header file don’t cause linker errors when the header is included in multiple source files
+// Source: https://stackoverflow.com/questions/5057021/why-do-inline-functions-have-to-be-defined-in-a-header-file
+// -----------------------------------------------------------------------------
+
+#include <string>         // image buffer + strings
+#include <cstring>        // memcpy / memcmp on the raw image
+#include <cstdio>         // fopen/fwrite/rename for the atomic save
+#include <stdint.h>       // fixed-width record fields
+#include <unordered_map>  // string -> id while deduplicating
+#include "tree.hpp"       // the catalog being saved / rebuilt
+#include "csv.hpp"        // MappedFile (mmap'd read of the snapshot)
+
+using namespace std;
+
+// Bump SNAPSHOT_VERSION whenever the layout below changes
+static const char     SNAPSHOT_MAGIC[8] = { 'L', 'C', 'M', 'S', 'S', 'N', 'A', 'P' };
+static const uint32_t SNAPSHOT_VERSION  = 2;
+static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+struct SnapshotHeader
+{
+	char     magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint32_t nodeCount;
+	uint32_t bookCount;
+	uint32_t stringCount;
+	uint32_t reserved;     // keeps stringBytes 8-byte aligned
+	uint64_t stringBytes;
+	uint64_t journalSeq;   // v2: last journal record folded into this image (0 = none)
+};
+
+// Version 1 headers stop before journalSeq
+static const size_t SNAPSHOT_V1_HEADER_SIZE = 40;
+
+struct SnapshotNode
+{
+	int32_t  parent;       // index into nodes, -1 for the root
+	uint32_t name;         // string id
+	uint32_t bookCount;    // books stored directly in this node
+};
+
+struct SnapshotBook
+{
+	uint32_t title;        // string ids
+	uint32_t author;
+	uint32_t isbn;
+	int32_t  year;
+};
+
+// Flatten the whole tree into 'image' (in memory; nothing is written yet)
+void snapshotEncode(const Tree& tree, string& image, uint64_t journalSeq = 0);
+
+// Write an encoded image to 'path' via a temp file + rename (never half-written);
+// the file and the directory entry are both synced before it returns true
+bool snapshotWriteFile(const string& image, const string& path);
+
+// Encode + write in one go; returns false if the file can't be written
+bool snapshotSave(const Tree& tree, const string& path, uint64_t journalSeq = 0);
+
+// Rebuild a Tree from an image; nullptr (and 'error' set) if it is malformed.
+// 'journalSeq' (optional) receives the journal position stored in the header.
+Tree* snapshotDecode(const char* data, size_t size, string& error, uint64_t* journalSeq = nullptr);
+
+// Map 'path' and decode it
+Tree* snapshotLoad(const string& path, string& error, uint64_t* journalSeq = nullptr);
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+// Append the raw bytes of a fixed-size record
+template <typename T>
+inline void _snap_put(string& image, const T& value) {
+	image.append((const char*)&value, sizeof(T));
+}
+
+// Hands out one id per distinct string (authors and category names repeat a lot)
+class _SnapStringTable
+{
+	private:
+		unordered_map<string, uint32_t> ids;
+
+	public:
+		MyVector<const string*> order; // id -> string (points at the map's keys)
+
+		uint32_t idOf(const string& s) {
+			unordered_map<string, uint32_t>::iterator it = ids.find(s);
+			if (it != ids.end()) return it->second;
+			uint32_t id = (uint32_t)order.size();
+			it = ids.insert(make_pair(s, id)).first;
+			order.push_back(&it->first);
+			return id;
+		}
+};
+
+inline void snapshotEncode(const Tree& tree, string& image, uint64_t journalSeq) {
+	image.clear();
+	_SnapStringTable strings;
+	MyVector<SnapshotNode> nodes;
+	MyVector<SnapshotBook> books;
+
+	// Iterative preorder that visits children in their stored order
+	MyVector<const Node*> stack;
+	MyVector<int> parentOf;
+	stack.push_back(tree.getRoot());
+	parentOf.push_back(-1);
+
+	while (!stack.empty()) {
+		const Node* cur = stack.pop_back();
+		int parent = parentOf.pop_back();
+
+		const MyVector<Book*>& local = cur->getBooks();
+		SnapshotNode sn;
+		sn.parent = parent;
+		sn.name = strings.idOf(cur->getName());
+		sn.bookCount = (uint32_t)local.size();
+		int myIndex = nodes.size();
+		nodes.push_back(sn);
+
+		for (size_t i = 0; i < local.size(); ++i) {
+			SnapshotBook sb;
+			sb.title  = strings.idOf(local[i]->getTitle());
+			sb.author = strings.idOf(local[i]->getAuthor());
+			sb.isbn   = strings.idOf(local[i]->getISBN());
+			sb.year   = local[i]->getYear();
+			books.push_back(sb);
+		}
+
+		// Push in reverse so the first child is popped (and numbered) first
+		const MyVector<Node*>& kids = cur->getChildren();
+		for (int i = (int)kids.size() - 1; i >= 0; --i) {
+			stack.push_back(kids[i]);
+			parentOf.push_back(myIndex);
+		}
+	}
+
+	uint64_t stringBytes = 0;
+	for (size_t i = 0; i < strings.order.size(); ++i) stringBytes += strings.order[i]->size();
+
+	SnapshotHeader header;
+	memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version = SNAPSHOT_VERSION;
+	header.byteOrder = SNAPSHOT_BYTE_ORDER;
+	header.nodeCount = (uint32_t)nodes.size();
+	header.bookCount = (uint32_t)books.size();
+	header.stringCount = (uint32_t)strings.order.size();
+	header.reserved = 0;
+	header.stringBytes = stringBytes;
+	header.journalSeq = journalSeq;
+
+	image.reserve(sizeof(header) + (strings.order.size() + 1) * sizeof(uint64_t) +
+	              nodes.size() * sizeof(SnapshotNode) + books.size() * sizeof(SnapshotBook) + stringBytes);
+	_snap_put(image, header);
+
+	uint64_t offset = 0;
+	for (size_t i = 0; i < strings.order.size(); ++i) {
+		_snap_put(image, offset);
+		offset += strings.order[i]->size();
+	}
+	_snap_put(image, offset);
+
+	image.append((const char*)nodes.data(), nodes.size() * sizeof(SnapshotNode));
+	if (books.size() > 0) image.append((const char*)books.data(), books.size() * sizeof(SnapshotBook));
+	for (size_t i = 0; i < strings.order.size(); ++i) image += *strings.order[i];
+}
+
+inline bool snapshotWriteFile(const string& image, const string& path) {
+	string tmp = path + ".tmp";
+	FILE* f = fopen(tmp.c_str(), "wb");
+	if (!f) return false;
+
+	bool ok = fwrite(image.data(), 1, image.size(), f) == image.size();
+	ok = (fflush(f) == 0) && ok;
+#ifdef LCMS_HAVE_MMAP
+	ok = ok && fsync(fileno(f)) == 0; // make sure the bytes are on disk before the rename
+#endif
+	ok = (fclose(f) == 0) && ok;
+
+	if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+		remove(tmp.c_str());
+		return false;
+	}
+	// The rename must be on disk before anything it replaces (a retired journal) is deleted
+	return fsyncParentDir(path);
+}
+
+inline bool snapshotSave(const Tree& tree, const string& path, uint64_t journalSeq) {
+	string image;
+	snapshotEncode(tree, image, journalSeq);
+	return snapshotWriteFile(image, path);
+}
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+// Copy string 'id' out of the blob (ids and offsets were validated by the caller)
+inline string _snap_string(const char* blob, const MyVector<uint64_t>& offsets, uint32_t id) {
+	return string(blob + offsets[(int)id], (size_t)(offsets[(int)id + 1] - offsets[(int)id]));
+}
+
+inline Tree* snapshotDecode(const char* data, size_t size, string& error, uint64_t* journalSeq) {
+	SnapshotHeader header;
+	if (size < SNAPSHOT_V1_HEADER_SIZE) { error = "file is too small"; return nullptr; }
+	memset(&header, 0, sizeof(header));
+	memcpy(&header, data, SNAPSHOT_V1_HEADER_SIZE);
+
+	if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) { error = "not a catalog snapshot"; return nullptr; }
+	if (header.byteOrder != SNAPSHOT_BYTE_ORDER) { error = "snapshot was written on a different byte order"; return nullptr; }
+	if (header.version != 1 && header.version != SNAPSHOT_VERSION) { error = "unsupported snapshot version"; return nullptr; }
+
+	// v1 images have the shorter header and no journal position
+	size_t headerSize = (header.version == 1) ? SNAPSHOT_V1_HEADER_SIZE : sizeof(header);
+	if (size < headerSize) { error = "file is too small"; return nullptr; }
+	memcpy(&header, data, headerSize);
+	if (header.nodeCount == 0) { error = "snapshot has no root"; return nullptr; }
+
+	// Every table must fit exactly; this also bounds all reads below
+	uint64_t offsetsBytes = ((uint64_t)header.stringCount + 1) * sizeof(uint64_t);
+	uint64_t nodesBytes   = (uint64_t)header.nodeCount * sizeof(SnapshotNode);
+	uint64_t booksBytes   = (uint64_t)header.bookCount * sizeof(SnapshotBook);
+	uint64_t expected     = headerSize + offsetsBytes + nodesBytes + booksBytes + header.stringBytes;
+	if (expected != (uint64_t)size) { error = "snapshot is truncated or corrupt"; return nullptr; }
+
+	const char* offsetsAt = data + headerSize;
+	const char* nodesAt   = offsetsAt + offsetsBytes;
+	const char* booksAt   = nodesAt + nodesBytes;
+	const char* blob      = booksAt + booksBytes;
+
+	// String ids -> [begin, end) in the blob (checked once up front)
+	MyVector<uint64_t> offsets;
+	offsets.reserve((int)header.stringCount + 1);
+	for (uint32_t i = 0; i <= header.stringCount; ++i) {
+		uint64_t off;
+		memcpy(&off, offsetsAt + i * sizeof(uint64_t), sizeof(off));
+		if (off > header.stringBytes || (i > 0 && off < offsets[i - 1])) { error = "bad string table"; return nullptr; }
+		offsets.push_back(off);
+	}
+
+	MyVector<SnapshotNode> nodes;
+	nodes.reserve((int)header.nodeCount);
+	uint64_t booksClaimed = 0;
+	for (uint32_t i = 0; i < header.nodeCount; ++i) {
+		SnapshotNode sn;
+		memcpy(&sn, nodesAt + i * sizeof(SnapshotNode), sizeof(sn));
+		bool parentOk = (i == 0) ? (sn.parent == -1) : (sn.parent >= 0 && (uint32_t)sn.parent < i);
+		if (!parentOk || sn.name >= header.stringCount) { error = "bad node table"; return nullptr; }
+		booksClaimed += sn.bookCount;
+		nodes.push_back(sn);
+	}
+	if (booksClaimed != header.bookCount) { error = "bad node table"; return nullptr; }
+
+	// Rebuild: nodes in preorder (parents always exist already), books per node
+	Tree* tree = new Tree(_snap_string(blob, offsets, nodes[0].name));
+	MyVector<Node*> built;
+	built.reserve((int)header.nodeCount);
+	built.push_back(tree->getRoot());
+	for (uint32_t i = 1; i < header.nodeCount; ++i) {
+		built.push_back(tree->appendChild(built[nodes[i].parent], _snap_string(blob, offsets, nodes[i].name)));
+	}
+
+	uint32_t b = 0;
+	for (uint32_t i = 0; i < header.nodeCount; ++i) {
+		for (uint32_t k = 0; k < nodes[i].bookCount; ++k, ++b) {
+			SnapshotBook sb;
+			memcpy(&sb, booksAt + (uint64_t)b * sizeof(SnapshotBook), sizeof(sb));
+			if (sb.title >= header.stringCount || sb.author >= header.stringCount || sb.isbn >= header.stringCount) {
+				delete tree;
+				error = "bad book table";
+				return nullptr;
+			}
+			// A duplicate is dropped by addBook; only a hand-edited file could hit this
+			tree->addBook(built[i], Book(_snap_string(blob, offsets, sb.title),
+			                             _snap_string(blob, offsets, sb.author),
+			                             _snap_string(blob, offsets, sb.isbn), sb.year));
+		}
+	}
+	if (journalSeq) *journalSeq = header.journalSeq;
+	return tree;
+}
+
+inline Tree* snapshotLoad(const string& path, string& error, uint64_t* journalSeq) {
+	MappedFile file;
+	if (!file.open(path)) { error = "could not open file"; return nullptr; }
+	return snapshotDecode(file.data(), file.size(), error, journalSeq);
+}
+
+// -----------------------------------------------------------------------------
+// End guard: keep headers clean and avoid accidental extra code below.
+// -----------------------------------------------------------------------------
+#endif
@@ -0,0 +1,181 @@
+#ifndef _STRINGPOOL_H
+#define _STRINGPOOL_H
+
+// -----------------------------------------------------------------------------
+// Library Catalog Project — StringPool (interned strings behind small ids).
+// Thousands of books share an author and every category name is repeated in
+// paths, yet each Book/Node used to own a private copy. The pool keeps one copy
+// of each distinct text and hands out a 32-bit id for it; two ids are equal
+// exactly when the texts are, so comparing them is one integer compare.
+// Ids are reference counted: intern()/retain() take a reference, release()
+// drops one, and a text nobody references any more is erased and its id is
+// reused. Book and Node hold exactly one reference per id they store, so the
+// authors and names of removed books, categories and replaced trees go away
+// with them. Id 0 ("") is never released.
+// intern/retain/release/find serialize on one mutex. text() takes no lock: id
+// slots live in fixed chunks that never move, so a thread may read the text
+// of any id it holds a reference to while others intern.
+// I use inline functions so that the function definitions inside the header file don’t cause linker errors when the header is included in multiple source files
+// Source: https://stackoverflow.com/questions/5057021/why-do-inline-functions-have-to-be-defined-in-a-header-file
+// -----------------------------------------------------------------------------
+
+#include <string>         // pooled text
+#include <unordered_map>  // text -> id (its keys are the only copies)
+#include <mutex>          // intern/release from any thread
+#include <stdint.h>       // 32-bit ids
+#include <stdexcept>      // std::length_error once the id table is full
+#include "myvector.hpp"   // reusable ids
+
+using std::string;
+using std::unordered_map;
+
+class StringPool
+{
+	private:
+		// One id: its text (the key stored in 'ids') and how many holders it has
+		struct Slot
+		{
+			const string* text;
+			uint32_t refs;
+		};
+
+		// Ids map to CHUNK-sized blocks of slots; blocks are never moved or freed
+		// while the pool lives, which is what makes text() lock-free.
+		// (MAX_CHUNKS * CHUNK = 2^28 distinct texts at once; intern() throws past that.)
+		static const uint32_t CHUNK_BITS = 12;
+		static const uint32_t CHUNK = 1u << CHUNK_BITS;
+		static const uint32_t MAX_CHUNKS = 1u << 16;
+
+		// Text -> id. Node-based, so key addresses stay put while the map grows.
+		unordered_map<string, uint32_t> ids;
+
+		// Chunk table (MAX_CHUNKS entries, allocated once) and slots handed out so far
+		Slot** chunks;
+		uint32_t slotCount;
+
+		// Released ids, handed out again before new ones
+		MyVector<uint32_t> freeIds;
+
+		// Live texts
+		int live;
+
+		mutable std::mutex lock;
+
+		Slot& slot(uint32_t id) const;
+
+	public:
+		// Starts with "" as id 0, so default-constructed fields need no lookup
+		StringPool();
+		~StringPool();
+
+		StringPool(const StringPool&) = delete;
+		StringPool& operator=(const StringPool&) = delete;
+
+		// Id for 'text', adding it on first sight; the caller holds one reference
+		uint32_t intern(const string& text);
+
+		// Take / drop one more reference to an id the caller already holds
+		void retain(uint32_t id);
+		void release(uint32_t id);
+
+		// Id for 'text' if it is currently interned (no reference is taken)
+		bool find(const string& text, uint32_t& id) const;
+
+		// The text behind an id (stable while the id is referenced)
+		const string& text(uint32_t id) const;
+
+		// Number of distinct live texts
+		int size() const;
+};
+
+// The one pool shared by books and categories
+inline StringPool& stringPool() {
+	static StringPool pool;
+	return pool;
+}
+
+// ============================================================================
+// StringPool methods
+// ============================================================================
+
+inline StringPool::StringPool() {
+	chunks = new Slot*[MAX_CHUNKS]();
+	slotCount = 0;
+	live = 0;
+	intern("");
+}
+
+inline StringPool::~StringPool() {
+	for (uint32_t c = 0; c < MAX_CHUNKS && chunks[c] != nullptr; ++c) delete [] chunks[c];
+	delete [] chunks;
+}
+
+inline StringPool::Slot& StringPool::slot(uint32_t id) const {
+	return chunks[id >> CHUNK_BITS][id & (CHUNK - 1)];
+}
+
+inline uint32_t StringPool::intern(const string& text) {
+	std::lock_guard<std::mutex> guard(lock);
+	unordered_map<string, uint32_t>::iterator it = ids.find(text);
+	if (it != ids.end()) {
+		slot(it->second).refs++;
+		return it->second;
+	}
+
+	uint32_t id;
+	if (!freeIds.empty()) {
+		id = freeIds.back();
+		freeIds.pop_back();
+	} else {
+		if ((slotCount >> CHUNK_BITS) >= MAX_CHUNKS)
+			throw std::length_error("StringPool: too many distinct strings");
+		id = slotCount;
+		if ((id & (CHUNK - 1)) == 0) chunks[id >> CHUNK_BITS] = new Slot[CHUNK];
+		slotCount++;
+	}
+	it = ids.insert(std::make_pair(text, id)).first;
+	slot(id).text = &it->first;
+	slot(id).refs = 1;
+	live++;
+	return id;
+}
+
+inline void StringPool::retain(uint32_t id) {
+	if (id == 0) return;
+	std::lock_guard<std::mutex> guard(lock);
+	slot(id).refs++;
+}
+
+// The last reference erases the text and frees its id
+inline void StringPool::release(uint32_t id) {
+	if (id == 0) return;
+	std::lock_guard<std::mutex> guard(lock);
+	Slot& s = slot(id);
+	if (--s.refs > 0) return;
+	ids.erase(*s.text);
+	s.text = nullptr;
+	freeIds.push_back(id);
+	live--;
+}
+
+inline bool StringPool::find(const string& text, uint32_t& id) const {
+	std::lock_guard<std::mutex> guard(lock);
+	unordered_map<string, uint32_t>::const_iterator it = ids.find(text);
+	if (it == ids.end()) return false;
+	id = it->second;
+	return true;
+}
+
+inline const string& StringPool::text(uint32_t id) const {
+	return *slot(id).text;
+}
+
+inline int StringPool::size() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return live;
+}
+
+// -----------------------------------------------------------------------------
+// End guard: keep headers clean and avoid accidental extra code below.
+// -----------------------------------------------------------------------------
+#endif
@@ -0,0 +1,451 @@
+//============================================================================
+// Name         : persistence_check.cpp
+// Description  : Crash-safety checks for snapshots, the journal and checkpoints.
+//
+// Each check writes catalog files the way a crash would leave them, reopens
+// them through LCMS::openCatalog (or the snapshot decoder) and compares the
+// resulting export with the catalog it should hold:
+//   - snapshot round-trip: encode -> decode -> encode gives the same bytes
+//   - every truncated prefix and a set of corrupted snapshots are refused
+//     (single-byte flips are decoded or refused, never crash; build with
+//     -fsanitize=address to make that part meaningful)
+//   - a torn or garbled last journal record is cut off, and records appended
+//     after the cut replay on the next start
+//   - crash between journal rotate and snapshot write: "<journal>.old" is
+//     replayed before "<journal>", then folded into a new checkpoint
+//   - crash after the snapshot write but before "<journal>.old" is deleted:
+//     the records the snapshot already holds are skipped
+//   - a checkpoint whose child cannot write the snapshot (its directory is
+//     missing, so the child exits non-zero): the failure is reported,
+//     "<journal>.old" is kept and the next start replays it
+//   - fsyncParentDir, which orders the renames before the segment delete,
+//     syncs existing directories and reports missing ones
+//
+// Build & run from the repo root:
+//   g++ -std=c++11 -O2 -pthread -o persistence_check tests/persistence_check.cpp
+//   ./persistence_check [scratch_dir]      (default: current directory)
+// Prints one line per check and exits with 1 if any of them failed.
+//============================================================================
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "../lcms.hpp"
+
+using namespace std;
+
+static int failures = 0;
+
+static void report(const string& name, bool ok, const string& detail = "") {
+	cout << (ok ? "ok   " : "FAIL ") << name;
+	if (!ok && detail.size() > 0) cout << ": " << detail;
+	cout << endl;
+	if (!ok) failures++;
+}
+
+// -----------------------------------------------------------------------------
+// Files and console
+// -----------------------------------------------------------------------------
+static string readFile(const string& path) {
+	ifstream in(path.c_str(), ios::binary);
+	ostringstream data;
+	data << in.rdbuf();
+	return data.str();
+}
+
+static void writeFile(const string& path, const string& data) {
+	ofstream out(path.c_str(), ios::binary | ios::trunc);
+	out.write(data.data(), (streamsize)data.size());
+}
+
+static bool fileExists(const string& path) {
+	ifstream in(path.c_str());
+	return in.good();
+}
+
+// Collects what LCMS prints while it is alive, so the report stays readable
+struct CaptureCout
+{
+	ostringstream text;
+	streambuf* saved;
+	CaptureCout() { saved = cout.rdbuf(text.rdbuf()); }
+	~CaptureCout() { cout.rdbuf(saved); }
+};
+
+// -----------------------------------------------------------------------------
+// Catalogs
+// -----------------------------------------------------------------------------
+
+// A small catalog with the awkward cases: quotes and commas, UTF-8, no ISBN,
+// negative years, an empty category and a shared author
+static void buildSample(Tree& tree) {
+	tree.createNode("Empty/Category");
+	tree.addBook(tree.createNode("Fiction"), Book("Dune", "Frank Herbert", "9780441013593", 1965));
+	tree.addBook(tree.createNode("Fiction/Classics"), Book("War and Peace", "Leo Tolstoy", "0-14-044793-X", 1869));
+	tree.addBook(tree.createNode("Fiction/Classics"), Book("Quotes \"and\", commas", "Anon", "", -500));
+	tree.addBook(tree.createNode("Science/Physics"), Book("\xC3\x9C" "ber Licht", "Zo\xC3\xAB", "978-3-16-148410-0", 2001));
+	tree.addBook(tree.createNode("Science/Biology/Genetics"), Book("Genes", "Frank Herbert", "", 1999));
+}
+
+// What LCMS exports for 'tree' (via a snapshot, the only way in without a journal)
+static string exportOf(const Tree& tree, const string& dir) {
+	string snap = dir + "/pc_expected.snap";
+	string csv = dir + "/pc_expected.csv";
+	snapshotSave(tree, snap, 0);
+	{
+		CaptureCout quiet;
+		LCMS lcms("Library");
+		lcms.openCatalog(snap, "");
+		lcms.exportData(csv);
+	}
+	string data = readFile(csv);
+	remove(snap.c_str());
+	remove(csv.c_str());
+	return data;
+}
+
+static string exportOf(LCMS& lcms, const string& dir) {
+	string csv = dir + "/pc_actual.csv";
+	lcms.exportData(csv);
+	string data = readFile(csv);
+	remove(csv.c_str());
+	return data;
+}
+
+// Queue one journal record and mirror it on the expected tree
+static void journalAddBook(Journal& journal, Tree& expected, const string& path, const Book& book) {
+	JournalRecord record;
+	record.op = JOURNAL_ADD_BOOK;
+	record.path = path;
+	record.book = book;
+	journal.append(record);
+	expected.addBook(expected.createNode(path), book);
+}
+
+static void journalRemoveCategory(Journal& journal, Tree& expected, const string& path) {
+	JournalRecord record;
+	record.op = JOURNAL_REMOVE_CATEGORY;
+	record.path = path;
+	journal.append(record);
+	expected.removeNode(path);
+}
+
+static void removeCatalogFiles(const string& snap, const string& jrn) {
+	remove(snap.c_str());
+	remove((snap + ".tmp").c_str());
+	remove(jrn.c_str());
+	remove(journalRetiredPath(jrn).c_str());
+}
+
+// -----------------------------------------------------------------------------
+// Snapshots
+// -----------------------------------------------------------------------------
+static void checkSnapshotRoundTrip() {
+	Tree tree("Library");
+	buildSample(tree);
+	string image;
+	snapshotEncode(tree, image, 42);
+
+	string error;
+	uint64_t seq = 0;
+	Tree* back = snapshotDecode(image.data(), image.size(), error, &seq);
+	if (!back) {
+		report("snapshot round-trip", false, error);
+		return;
+	}
+	string again;
+	snapshotEncode(*back, again, seq);
+	bool ok = again == image && seq == 42 && back->getRoot()->getBookCount() == tree.getRoot()->getBookCount();
+	delete back;
+	report("snapshot round-trip", ok, "re-encoded image differs");
+}
+
+static bool refused(const string& image) {
+	string error;
+	Tree* tree = snapshotDecode(image.data(), image.size(), error);
+	delete tree;
+	return tree == nullptr;
+}
+
+static void checkSnapshotDamage() {
+	Tree tree("Library");
+	buildSample(tree);
+	string image;
+	snapshotEncode(tree, image, 7);
+
+	size_t accepted = 0;
+	for (size_t len = 0; len < image.size(); ++len) {
+		if (!refused(image.substr(0, len))) accepted++;
+	}
+	report("truncated snapshots refused", accepted == 0, to_string(accepted) + " prefixes decoded");
+
+	// Table positions, as laid out in snapshot.hpp
+	SnapshotHeader header;
+	memcpy(&header, image.data(), sizeof(header));
+	size_t offsetsAt = sizeof(SnapshotHeader);
+	size_t nodesAt = offsetsAt + ((size_t)header.stringCount + 1) * sizeof(uint64_t);
+	size_t booksAt = nodesAt + (size_t)header.nodeCount * sizeof(SnapshotNode);
+
+	string bad;
+	int missed = 0;
+
+	bad = image; bad[0] ^= 1;                                   // magic
+	if (!refused(bad)) missed++;
+	bad = image; bad[8] = 99;                                   // version
+	if (!refused(bad)) missed++;
+	bad = image; bad += '\0';                                   // trailing garbage
+	if (!refused(bad)) missed++;
+
+	bad = image;                                                // string offset past the blob
+	uint64_t past = header.stringBytes + 1;
+	memcpy(&bad[offsetsAt + sizeof(uint64_t)], &past, sizeof(past));
+	if (!refused(bad)) missed++;
+
+	bad = image;                                                // node whose parent comes later
+	int32_t forward = (int32_t)header.nodeCount;
+	memcpy(&bad[nodesAt + sizeof(SnapshotNode) + offsetof(SnapshotNode, parent)], &forward, sizeof(forward));
+	if (!refused(bad)) missed++;
+
+	bad = image;                                                // book with an unknown author id
+	uint32_t unknown = header.stringCount;
+	memcpy(&bad[booksAt + offsetof(SnapshotBook, author)], &unknown, sizeof(unknown));
+	if (!refused(bad)) missed++;
+
+	report("corrupt snapshots refused", missed == 0, to_string(missed) + " corruptions decoded");
+
+	// Any single flipped byte must decode or be refused; the sanitizers catch the rest
+	for (size_t i = 0; i < image.size(); ++i) {
+		bad = image;
+		bad[i] ^= 0x5A;
+		refused(bad);
+	}
+	report("single-byte flips handled", true);
+}
+
+// -----------------------------------------------------------------------------
+// Journal: torn tail
+// -----------------------------------------------------------------------------
+static void checkTornTail(const string& dir) {
+	string snap = dir + "/pc_torn.snap";
+	string jrn = dir + "/pc_torn.jrn";
+	string csv = dir + "/pc_torn.csv";
+	removeCatalogFiles(snap, jrn);
+
+	// Two intact records, then a third that the crash tears
+	Tree expected("Library");
+	Tree discarded("Library");
+	size_t intactBytes;
+	{
+		Journal journal;
+		journal.open(jrn, 0, 1);
+		journalAddBook(journal, expected, "Fiction", Book("Dune", "Frank Herbert", "9780441013593", 1965));
+		journalAddBook(journal, expected, "Science", Book("Cosmos", "Carl Sagan", "", 1980));
+		journal.commit();
+		intactBytes = readFile(jrn).size();
+		journalAddBook(journal, discarded, "Fiction", Book("Emma", "Jane Austen", "", 1815));
+		journal.commit();
+	}
+	string full = readFile(jrn);
+	string want = exportOf(expected, dir);
+
+	// Rows added after the cut (same result whatever the cut point was)
+	writeFile(csv, "Title,Author,ISBN,Year,Category\n\"Walden\",\"Henry Thoreau\",\"\",\"1854\",\"Essays\"\n");
+	Tree after("Library");
+	after.addBook(after.createNode("Fiction"), Book("Dune", "Frank Herbert", "9780441013593", 1965));
+	after.addBook(after.createNode("Science"), Book("Cosmos", "Carl Sagan", "", 1980));
+	after.addBook(after.createNode("Essays"), Book("Walden", "Henry Thoreau", "", 1854));
+	string wantAfter = exportOf(after, dir);
+
+	// Every cut inside the last record, plus the whole record with a garbled byte
+	int bad = 0;
+	string firstError;
+	for (size_t cut = intactBytes + 1; cut <= full.size(); ++cut) {
+		string torn = full.substr(0, cut);
+		if (cut == full.size()) torn[torn.size() - 1] ^= 0x20;
+		writeFile(jrn, torn);
+
+		string got, gotAfter;
+		size_t keptBytes;
+		{
+			CaptureCout quiet;
+			LCMS lcms("Library");
+			if (!lcms.openCatalog(snap, jrn)) { bad++; continue; }
+			got = exportOf(lcms, dir);
+			lcms.import(csv);
+		}
+		keptBytes = readFile(jrn).size();
+		{
+			CaptureCout quiet;
+			LCMS lcms("Library");
+			if (!lcms.openCatalog(snap, jrn)) { bad++; continue; }
+			gotAfter = exportOf(lcms, dir);
+		}
+		if (got != want || gotAfter != wantAfter || keptBytes <= intactBytes) {
+			if (bad == 0) firstError = "cut at byte " + to_string(cut);
+			bad++;
+		}
+	}
+	report("torn journal tail cut off and appended after", bad == 0, firstError);
+
+	remove(csv.c_str());
+	removeCatalogFiles(snap, jrn);
+}
+
+// -----------------------------------------------------------------------------
+// Checkpoints: crashes around the rotate / snapshot write / segment delete
+// -----------------------------------------------------------------------------
+
+// Base snapshot at seq 0; records 1-3 go to the segment a checkpoint retired,
+// records 4-5 to the live journal. Replaying the live journal first would keep
+// "Moved" (and "Lost") around, so the order shows in the result.
+static uint64_t writeRotatedJournal(const string& jrn, Tree& expected) {
+	Journal journal;
+	journal.open(jrn, 0, 1);
+	journalAddBook(journal, expected, "Moved/Here", Book("Lost", "Nobody", "", 1900));
+	journalAddBook(journal, expected, "Fiction", Book("Emma", "Jane Austen", "", 1815));
+	journalAddBook(journal, expected, "Moved/Other", Book("Gone", "Nobody", "", 1901));
+	journal.rotate(journalRetiredPath(jrn));
+	journalRemoveCategory(journal, expected, "Moved");
+	journalAddBook(journal, expected, "Moved/Here", Book("Found", "Somebody", "", 2000));
+	journal.commit();
+	return journal.lastSeq();
+}
+
+static void checkCrashBeforeSnapshot(const string& dir) {
+	string snap = dir + "/pc_rot.snap";
+	string jrn = dir + "/pc_rot.jrn";
+	removeCatalogFiles(snap, jrn);
+
+	Tree expected("Library");
+	buildSample(expected);
+	snapshotSave(expected, snap, 0);
+	uint64_t lastSeq = writeRotatedJournal(jrn, expected);
+	string want = exportOf(expected, dir);
+
+	// The checkpoint never wrote its snapshot: both segments replay, retired first
+	string got, log;
+	{
+		CaptureCout capture;
+		LCMS lcms("Library");
+		if (lcms.openCatalog(snap, jrn)) got = exportOf(lcms, dir);
+		log = capture.text.str();
+	} // waits for the checkpoint openCatalog started
+	report("retired segment replayed before the live journal", got == want && log.find("5 journal records have been replayed") != string::npos);
+
+	string error;
+	uint64_t seq = 0;
+	Tree* folded = snapshotLoad(snap, error, &seq);
+	bool ok = folded != nullptr && seq == lastSeq && !fileExists(journalRetiredPath(jrn));
+	delete folded;
+	report("retired segment folded into a new checkpoint", ok, error);
+
+	string reopened;
+	{
+		CaptureCout capture;
+		LCMS lcms("Library");
+		if (lcms.openCatalog(snap, jrn)) reopened = exportOf(lcms, dir);
+		log = capture.text.str();
+	}
+	report("restart after the checkpoint", reopened == want && log.find("0 journal records have been replayed") != string::npos);
+
+	removeCatalogFiles(snap, jrn);
+}
+
+static void checkCrashBeforeSegmentDelete(const string& dir) {
+	string snap = dir + "/pc_del.snap";
+	string jrn = dir + "/pc_del.jrn";
+	removeCatalogFiles(snap, jrn);
+
+	// The new snapshot (records 1-3) reached the disk, the retired segment was not deleted yet
+	Tree expected("Library");
+	buildSample(expected);
+	Tree partial("Library");
+	buildSample(partial);
+	writeRotatedJournal(jrn, expected);
+	partial.addBook(partial.createNode("Moved/Here"), Book("Lost", "Nobody", "", 1900));
+	partial.addBook(partial.createNode("Fiction"), Book("Emma", "Jane Austen", "", 1815));
+	partial.addBook(partial.createNode("Moved/Other"), Book("Gone", "Nobody", "", 1901));
+	snapshotSave(partial, snap, 3);
+	string want = exportOf(expected, dir);
+
+	string got, log;
+	{
+		CaptureCout capture;
+		LCMS lcms("Library");
+		if (lcms.openCatalog(snap, jrn)) got = exportOf(lcms, dir);
+		log = capture.text.str();
+	}
+	// Re-applying them would be rejected as duplicates and reported as mismatches
+	bool skipped = log.find("2 journal records have been replayed") != string::npos &&
+	               log.find("no longer matched") == string::npos;
+	report("records already in the snapshot are skipped", got == want && skipped);
+
+	removeCatalogFiles(snap, jrn);
+}
+
+static void checkFailedCheckpoint(const string& dir) {
+	string snap = dir + "/pc_missing_dir/pc_fail.snap"; // the child cannot create its temp file here
+	string jrn = dir + "/pc_fail.jrn";
+	removeCatalogFiles(snap, jrn);
+
+	Tree expected("Library");
+	writeRotatedJournal(jrn, expected);
+	string want = exportOf(expected, dir);
+
+	// openCatalog starts a checkpoint for the retired segment; wait for its report
+	string got, log;
+	{
+		CaptureCout capture;
+		LCMS lcms("Library");
+		if (lcms.openCatalog(snap, jrn)) got = exportOf(lcms, dir);
+		for (int tries = 0; tries < 500; ++tries) {
+			lcms.maybeCheckpoint();
+			if (capture.text.str().find("failed") != string::npos) break;
+			this_thread::sleep_for(chrono::milliseconds(10));
+		}
+		log = capture.text.str();
+	}
+	bool reported = log.find("Warning: checkpoint to " + snap + " failed") != string::npos;
+	report("failed checkpoint child is reported", got == want && reported);
+	report("failed checkpoint keeps the retired segment", fileExists(journalRetiredPath(jrn)));
+
+	string again;
+	{
+		CaptureCout capture;
+		LCMS lcms("Library");
+		if (lcms.openCatalog(snap, jrn)) again = exportOf(lcms, dir);
+		log = capture.text.str();
+	}
+	report("retired segment replayed after a failed checkpoint", again == want && log.find("5 journal records have been replayed") != string::npos);
+
+	removeCatalogFiles(snap, jrn);
+}
+
+static void checkDirectorySync(const string& dir) {
+	bool ok = fsyncParentDir(dir + "/pc_any_file") &&
+	          fsyncParentDir("pc_relative_file") &&
+	          !fsyncParentDir(dir + "/pc_missing_dir/pc_any_file");
+	report("directory sync helper", ok);
+}
+
+int main(int argc, char** argv) {
+	string dir = (argc > 1) ? argv[1] : ".";
+
+	checkSnapshotRoundTrip();
+	checkSnapshotDamage();
+	checkTornTail(dir);
+	checkCrashBeforeSnapshot(dir);
+	checkCrashBeforeSegmentDelete(dir);
+	checkFailedCheckpoint(dir);
+	checkDirectorySync(dir);
+
+	cout << (failures == 0 ? "all checks passed" : to_string(failures) + " check(s) failed") << endl;
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+#ifndef _TITLEINDEX_H
+#define _TITLEINDEX_H
+
+// -----------------------------------------------------------------------------
+// Library Catalog Project — TitleIndex (exact title -> where the book lives).
+// findBook, editBook and removeBook all start from "the book with this title";
+// without an index that is a DFS over the whole catalog. The Tree keeps this
+// hash index in sync on every book mutation, so the lookup is O(1) average and
+// the owning category comes with it (no second scan to remove the book).
+// Titles are not unique; all books sharing a title are kept and the Tree
+// decides which one the DFS would have reached first.
+// Entries are keyed by the title's hash rather than a copy of the title (the
+// Book already holds it); lookups compare the real titles, so a hash
+// collision only costs an extra string compare.
+// I use inline functions so that the function definitions inside the header file don’t cause linker errors when the header is included in multiple source files
+// Source: https://stackoverflow.com/questions/5057021/why-do-inline-functions-have-to-be-defined-in-a-header-file
+// -----------------------------------------------------------------------------
+
+#include <string>         // titles
+#include <unordered_map>  // title hash -> (node, book), one entry per book
+#include <functional>     // std::hash<string>
+#include "myvector.hpp"   // lookup results
+#include "book.hpp"       // Book model
+
+using namespace std;
+
+class Node; // defined in tree.hpp, which owns this index
+
+// One indexed book and the category holding it
+struct TitlePlace
+{
+	Node* node;
+	Book* book;
+};
+
+class TitleIndex
+{
+	private:
+		typedef unordered_multimap<size_t, TitlePlace> PlaceMap;
+		PlaceMap places;
+		hash<string> hasher;
+
+	public:
+		// Register a book under 'title' (the value it is stored under)
+		void add(const string& title, Node* node, Book* book);
+
+		// Unregister 'book' from 'title'; returns its node (nullptr if it was not there)
+		Node* remove(const string& title, const Book* book);
+
+		// Forget everything
+		void clear();
+
+		// Every book with exactly this title (appended to 'out'); 0 if none
+		int lookup(const string& title, MyVector<TitlePlace>& out) const;
+};
+
+// ============================================================================
+// TitleIndex methods
+// ============================================================================
+
+inline void TitleIndex::add(const string& title, Node* node, Book* book) {
+	TitlePlace place;
+	place.node = node;
+	place.book = book;
+	places.insert(make_pair(hasher(title), place));
+}
+
+inline Node* TitleIndex::remove(const string& title, const Book* book) {
+	pair<PlaceMap::iterator, PlaceMap::iterator> range = places.equal_range(hasher(title));
+	for (PlaceMap::iterator it = range.first; it != range.second; ++it) {
+		if (it->second.book == book) {
+			Node* node = it->second.node;
+			places.erase(it);
+			return node;
+		}
+	}
+	return nullptr;
+}
+
+inline void TitleIndex::clear() {
+	places.clear();
+}
+
+inline int TitleIndex::lookup(const string& title, MyVector<TitlePlace>& out) const {
+	int found = 0;
+	pair<PlaceMap::const_iterator, PlaceMap::const_iterator> range = places.equal_range(hasher(title));
+	for (PlaceMap::const_iterator it = range.first; it != range.second; ++it) {
+		if (it->second.book->getTitle() != title) continue; // hash collision
+		out.push_back(it->second);
+		found++;
+	}
+	return found;
+}
+
+// -----------------------------------------------------------------------------
+// End guard: keep headers clean and avoid accidental extra code below.
+// -----------------------------------------------------------------------------
+#endif
@@ -0,0 +1,466 @@
+#ifndef _TOKENINDEX_H
+#define _TOKENINDEX_H
+
+// -----------------------------------------------------------------------------
+// Library Catalog Project — TokenIndex (inverted word index for keyword search).
+// Text is split into tokens: maximal runs of letters, digits and non-ASCII
+// bytes ("Daniel Kahneman, 2011" -> Daniel / Kahneman / 2011). Each token maps
+// to a posting list of document ids, and each id maps back to the item.
+//
+// find() matches raw substrings, not whole words. Split the keyword into its
+// token-character runs; wherever the keyword occurs, each run lies inside one
+// token of the text, and the separators around it pin down how:
+//   "a b c" -> b is a whole token, a ends a token, c starts a token
+//   "abc"   -> abc sits anywhere inside a token
+// A query takes the run whose matching tokens have the fewest postings,
+// collects those items, and the caller re-checks them with the exact
+// string::find test. That last step keeps results identical to a full scan;
+// the index only has to never miss a match.
+//
+// Runs that may sit anywhere inside a token ("Kahn" in "Kahneman") go through
+// a trigram index over the vocabulary: the run's rarest trigram names the few
+// tokens worth testing with string::find, instead of the whole vocabulary.
+// Runs shorter than three characters still scan the vocabulary.
+//
+// Removing an item only tombstones its id (O(1)); the stale ids (and tokens
+// nobody uses any more) are dropped in one pass once they make up half of all
+// postings.
+// I use inline functions so that the function definitions inside the header file don’t cause linker errors when the header is included in multiple source files
+// Source: https://stackoverflow.com/questions/5057021/why-do-inline-functions-have-to-be-defined-in-a-header-file
+// -----------------------------------------------------------------------------
+
+#include <string>         // tokens
+#include <unordered_map>  // token -> postings, item -> id
+#include <stdint.h>       // uint32_t ids
+#include <algorithm>      // sort / lower_bound over the sorted vocabulary views
+#include "myvector.hpp"   // posting lists and the id table
+
+using namespace std;
+
+// Letters, digits and any byte of a multi-byte UTF-8 sequence belong to tokens
+inline bool tokenChar(unsigned char c) {
+	return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+}
+
+// -----------------------------------------------------------------------------
+// TokenQueryRun: one token-character run of a keyword. A side is "open" when
+// the run touches that end of the keyword, i.e. the text may continue the
+// token there.
+// -----------------------------------------------------------------------------
+struct TokenQueryRun
+{
+	string text;
+	bool   openLeft;
+	bool   openRight;
+
+	// Could this run of the keyword sit inside 'token'?
+	bool fits(const string& token) const {
+		if (token.size() < text.size()) return false;
+		if (!openLeft && !openRight) return token == text;
+		if (!openLeft) return token.compare(0, text.size(), text) == 0;
+		if (!openRight) return token.compare(token.size() - text.size(), text.size(), text) == 0;
+		return token.find(text) != string::npos;
+	}
+};
+
+// Split 'keyword' into its token-character runs
+inline void tokenQueryRuns(const string& keyword, MyVector<TokenQueryRun>& runs) {
+	int n = (int)keyword.size();
+	int i = 0;
+	while (i < n) {
+		while (i < n && !tokenChar((unsigned char)keyword[i])) i++;
+		int start = i;
+		while (i < n && tokenChar((unsigned char)keyword[i])) i++;
+		if (i == start) break;
+
+		TokenQueryRun run;
+		run.text = keyword.substr(start, i - start);
+		run.openLeft = (start == 0);
+		run.openRight = (i == n);
+		runs.push_back(std::move(run));
+	}
+}
+
+// -----------------------------------------------------------------------------
+// TokenIndex: token -> items, for any item type with stable addresses.
+// -----------------------------------------------------------------------------
+template <typename T>
+class TokenIndex
+{
+	private:
+		// Document id -> item (nullptr once the item was removed)
+		MyVector<T*> docs;
+
+		// Document id -> how many posting entries it added (for the stale count)
+		MyVector<int> docPostings;
+
+		// Item -> its current document id
+		unordered_map<const T*, uint32_t> ids;
+
+		// Vocabulary: text -> token id, token id -> text and posting list
+		// (ids ascending, no repeats per id). The texts live in one array so a
+		// pass over the whole vocabulary is a linear scan.
+		unordered_map<string, uint32_t> tokenIds;
+		MyVector<string> tokens;
+		MyVector<MyVector<uint32_t>*> postings;
+
+		// Trigram -> ids of the tokens containing it (ascending, each id once)
+		unordered_map<uint32_t, MyVector<uint32_t> > gramTokens;
+		void indexGrams(uint32_t tokenId);
+
+		// Posting entries in total / entries that point at removed items
+		size_t totalPostings;
+		size_t stalePostings;
+
+		// Token ids sorted by text and by reversed text, for "starts with" and
+		// "ends with" runs. Only tokens [0, sortedCount) are in them; newer
+		// tokens are checked one by one until the next re-sort.
+		mutable MyVector<uint32_t> byText;
+		mutable MyVector<uint32_t> byReverse;
+		mutable size_t sortedCount;
+
+		// Per-query "already collected" marks (epoch trick: no clearing between queries)
+		mutable MyVector<uint32_t> seen;
+		mutable uint32_t epoch;
+
+		// Drop tombstoned ids and empty tokens, renumbering both
+		void compact();
+
+		// Re-sort byText/byReverse once too many tokens were added since the last sort
+		void refreshSorted() const;
+
+		// Collect the posting lists of every token 'run' fits; returns their total length
+		size_t matchRun(const TokenQueryRun& run, MyVector<const MyVector<uint32_t>*>& lists) const;
+
+	public:
+		TokenIndex();
+		~TokenIndex();
+
+		TokenIndex(const TokenIndex&) = delete;
+		TokenIndex& operator=(const TokenIndex&) = delete;
+
+		// Index the tokens of 'text' for 'item' (call once per field of the item)
+		void add(T* item, const string& text);
+
+		// Forget 'item' (its posting entries become stale)
+		void remove(T* item);
+
+		// Drop everything
+		void clear();
+
+		// Append every item whose text might contain 'keyword' (each item once).
+		// False if the keyword has no token characters, so the index cannot narrow it.
+		bool candidates(const string& keyword, MyVector<T*>& out) const;
+};
+
+// Three bytes of 's' starting at 'at', packed into one key
+inline uint32_t _token_gram(const string& s, size_t at) {
+	return ((uint32_t)(unsigned char)s[at] << 16) | ((uint32_t)(unsigned char)s[at + 1] << 8) | (uint32_t)(unsigned char)s[at + 2];
+}
+
+// a < b comparing from the last character backwards (order of the reversed strings)
+inline bool _token_reverseLess(const string& a, const string& b) {
+	size_t i = a.size(), j = b.size();
+	while (i > 0 && j > 0) {
+		unsigned char ca = (unsigned char)a[--i];
+		unsigned char cb = (unsigned char)b[--j];
+		if (ca != cb) return ca < cb;
+	}
+	return i == 0 && j > 0;
+}
+
+// ============================================================================
+// TokenIndex methods
+// ============================================================================
+
+template <typename T>
+inline TokenIndex<T>::TokenIndex() {
+	totalPostings = 0;
+	stalePostings = 0;
+	sortedCount = 0;
+	epoch = 0;
+}
+
+template <typename T>
+inline TokenIndex<T>::~TokenIndex() {
+	clear();
+}
+
+template <typename T>
+inline void TokenIndex<T>::add(T* item, const string& text) {
+	uint32_t id;
+	typename unordered_map<const T*, uint32_t>::iterator it = ids.find(item);
+	if (it != ids.end()) {
+		id = it->second;
+	} else {
+		id = (uint32_t)docs.size();
+		docs.push_back(item);
+		docPostings.push_back(0);
+		ids[item] = id;
+	}
+
+	int n = (int)text.size();
+	int i = 0;
+	string token;
+	while (i < n) {
+		while (i < n && !tokenChar((unsigned char)text[i])) i++;
+		int start = i;
+		while (i < n && tokenChar((unsigned char)text[i])) i++;
+		if (i == start) break;
+
+		token.assign(text, start, i - start);
+		unordered_map<string, uint32_t>::iterator known = tokenIds.find(token);
+		uint32_t tokenId;
+		if (known != tokenIds.end()) {
+			tokenId = known->second;
+		} else {
+			tokenId = (uint32_t)tokens.size();
+			tokenIds[token] = tokenId;
+			tokens.push_back(token);
+			postings.push_back(new MyVector<uint32_t>());
+			indexGrams(tokenId);
+		}
+
+		// An item repeating a word (or sharing it across fields) is listed once
+		MyVector<uint32_t>& list = *postings[(int)tokenId];
+		if (list.size() == 0 || list[list.size() - 1] != id) {
+			list.push_back(id);
+			docPostings[id]++;
+			totalPostings++;
+		}
+	}
+}
+
+template <typename T>
+inline void TokenIndex<T>::remove(T* item) {
+	typename unordered_map<const T*, uint32_t>::iterator it = ids.find(item);
+	if (it == ids.end()) return;
+	uint32_t id = it->second;
+	ids.erase(it);
+	docs[id] = nullptr;
+	stalePostings += docPostings[id];
+
+	if (stalePostings > 4096 && stalePostings * 2 > totalPostings) compact();
+}
+
+template <typename T>
+inline void TokenIndex<T>::clear() {
+	for (size_t i = 0; i < postings.size(); ++i) delete postings[i];
+	postings.clear();
+	tokens.clear();
+	tokenIds.clear();
+	gramTokens.clear();
+	docs.clear();
+	docPostings.clear();
+	ids.clear();
+	byText.clear();
+	byReverse.clear();
+	seen.clear();
+	sortedCount = 0;
+	totalPostings = 0;
+	stalePostings = 0;
+}
+
+template <typename T>
+inline void TokenIndex<T>::compact() {
+	// Old doc id -> new doc id, keeping live items in their old relative order
+	MyVector<uint32_t> remap;
+	MyVector<T*> liveDocs;
+	MyVector<int> livePostings;
+	remap.reserve(docs.size());
+	for (size_t i = 0; i < docs.size(); ++i) {
+		if (docs[i] == nullptr) {
+			remap.push_back(UINT32_MAX);
+		} else {
+			remap.push_back((uint32_t)liveDocs.size());
+			liveDocs.push_back(docs[i]);
+			livePostings.push_back(docPostings[i]);
+		}
+	}
+
+	// Filter every posting list; tokens nobody uses any more are dropped
+	MyVector<string> liveTokens;
+	MyVector<MyVector<uint32_t>*> livePostingLists;
+	tokenIds.clear();
+	totalPostings = 0;
+	for (size_t t = 0; t < tokens.size(); ++t) {
+		MyVector<uint32_t>& list = *postings[t];
+		size_t kept = 0;
+		for (size_t i = 0; i < list.size(); ++i) {
+			uint32_t mapped = remap[(int)list[i]];
+			if (mapped != UINT32_MAX) list[kept++] = mapped;
+		}
+		if (kept == 0) {
+			delete postings[t];
+			continue;
+		}
+		list.erase(list.begin() + kept, list.end());
+		list.shrink_to_fit();
+		totalPostings += kept;
+		tokenIds[tokens[t]] = (uint32_t)liveTokens.size();
+		liveTokens.push_back(std::move(tokens[t]));
+		livePostingLists.push_back(postings[t]);
+	}
+	tokens = std::move(liveTokens);
+	postings = std::move(livePostingLists);
+	gramTokens.clear();
+	for (size_t t = 0; t < tokens.size(); ++t) indexGrams((uint32_t)t);
+
+	docs = std::move(liveDocs);
+	docPostings = std::move(livePostings);
+	ids.clear();
+	for (size_t i = 0; i < docs.size(); ++i) ids[docs[i]] = (uint32_t)i;
+	seen.clear();
+	stalePostings = 0;
+
+	// Token ids changed, so the sorted views start over
+	byText.clear();
+	byReverse.clear();
+	sortedCount = 0;
+}
+
+template <typename T>
+inline void TokenIndex<T>::indexGrams(uint32_t tokenId) {
+	const string& text = tokens[(int)tokenId];
+	for (size_t i = 0; i + 3 <= text.size(); ++i) {
+		MyVector<uint32_t>& list = gramTokens[_token_gram(text, i)];
+		if (list.size() == 0 || list[list.size() - 1] != tokenId) list.push_back(tokenId);
+	}
+}
+
+template <typename T>
+inline void TokenIndex<T>::refreshSorted() const {
+	size_t unsorted = tokens.size() - sortedCount;
+	if (unsorted <= 256 + tokens.size() / 16) return;
+
+	byText.clear();
+	byText.reserve(tokens.size());
+	for (size_t t = 0; t < tokens.size(); ++t) byText.push_back((uint32_t)t);
+	byReverse = byText;
+
+	const MyVector<string>& text = tokens;
+	sort(byText.begin(), byText.end(), [&text](uint32_t a, uint32_t b) {
+		return text[(int)a] < text[(int)b];
+	});
+	sort(byReverse.begin(), byReverse.end(), [&text](uint32_t a, uint32_t b) {
+		return _token_reverseLess(text[(int)a], text[(int)b]);
+	});
+	sortedCount = tokens.size();
+}
+
+template <typename T>
+inline size_t TokenIndex<T>::matchRun(const TokenQueryRun& run, MyVector<const MyVector<uint32_t>*>& lists) const {
+	size_t cost = 0;
+	const string& key = run.text;
+
+	// Whole token: one hash lookup
+	if (!run.openLeft && !run.openRight) {
+		unordered_map<string, uint32_t>::const_iterator hit = tokenIds.find(key);
+		if (hit != tokenIds.end()) {
+			lists.push_back(postings[(int)hit->second]);
+			cost = postings[(int)hit->second]->size();
+		}
+		return cost;
+	}
+
+	// Anywhere inside a token: test only the tokens sharing the run's rarest trigram
+	if (run.openLeft && run.openRight && key.size() >= 3) {
+		const MyVector<uint32_t>* rarest = nullptr;
+		for (size_t i = 0; i + 3 <= key.size(); ++i) {
+			unordered_map<uint32_t, MyVector<uint32_t> >::const_iterator hit = gramTokens.find(_token_gram(key, i));
+			if (hit == gramTokens.end()) return 0; // no token has this trigram
+			if (rarest == nullptr || hit->second.size() < rarest->size()) rarest = &hit->second;
+		}
+		for (size_t i = 0; i < rarest->size(); ++i) {
+			int t = (int)(*rarest)[i];
+			if (tokens[t].find(key) == string::npos) continue;
+			lists.push_back(postings[t]);
+			cost += postings[t]->size();
+		}
+		return cost;
+	}
+
+	// Too short for trigrams: scan the vocabulary
+	if (run.openLeft && run.openRight) {
+		for (size_t t = 0; t < tokens.size(); ++t) {
+			if (tokens[t].size() < key.size() || tokens[t].find(key) == string::npos) continue;
+			lists.push_back(postings[t]);
+			cost += postings[t]->size();
+		}
+		return cost;
+	}
+
+	// Starts with / ends with: a contiguous range of the matching sorted view
+	refreshSorted();
+	const MyVector<string>& text = tokens;
+	if (run.openRight) {
+		const uint32_t* first = byText.begin();
+		const uint32_t* last = byText.end();
+		const uint32_t* at = lower_bound(first, last, key, [&text](uint32_t id, const string& k) {
+			return text[(int)id] < k;
+		});
+		for (; at != last && run.fits(text[(int)*at]); ++at) {
+			lists.push_back(postings[(int)*at]);
+			cost += postings[(int)*at]->size();
+		}
+	} else {
+		const uint32_t* first = byReverse.begin();
+		const uint32_t* last = byReverse.end();
+		const uint32_t* at = lower_bound(first, last, key, [&text](uint32_t id, const string& k) {
+			return _token_reverseLess(text[(int)id], k);
+		});
+		for (; at != last && run.fits(text[(int)*at]); ++at) {
+			lists.push_back(postings[(int)*at]);
+			cost += postings[(int)*at]->size();
+		}
+	}
+	for (size_t t = sortedCount; t < tokens.size(); ++t) {
+		if (!run.fits(tokens[t])) continue;
+		lists.push_back(postings[t]);
+		cost += postings[t]->size();
+	}
+	return cost;
+}
+
+template <typename T>
+inline bool TokenIndex<T>::candidates(const string& keyword, MyVector<T*>& out) const {
+	MyVector<TokenQueryRun> runs;
+	tokenQueryRuns(keyword, runs);
+	if (runs.size() == 0) return false;
+
+	// Every run must be satisfied, so the one with the fewest postings decides
+	MyVector<const MyVector<uint32_t>*> best, lists;
+	size_t bestCost = 0;
+	for (size_t r = 0; r < runs.size(); ++r) {
+		lists.clear();
+		size_t cost = matchRun(runs[r], lists);
+		if (cost == 0) return true; // some run matches no token at all: no results
+		if (r == 0 || cost < bestCost) {
+			best = lists;
+			bestCost = cost;
+		}
+	}
+
+	// New epoch: every id whose mark differs has not been collected by this query
+	while (seen.size() < docs.size()) seen.push_back(0);
+	if (++epoch == 0) {
+		for (size_t i = 0; i < seen.size(); ++i) seen[i] = 0;
+		epoch = 1;
+	}
+
+	for (size_t l = 0; l < best.size(); ++l) {
+		const MyVector<uint32_t>& list = *best[l];
+		for (size_t i = 0; i < list.size(); ++i) {
+			int id = (int)list[i];
+			if (docs[id] == nullptr || seen[id] == epoch) continue;
+			seen[id] = epoch;
+			out.push_back(docs[id]);
+		}
+	}
+	return true;
+}
+
+// -----------------------------------------------------------------------------
+// End guard: keep headers clean and avoid accidental extra code below.
+// -----------------------------------------------------------------------------
+#endif
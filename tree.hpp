@@ -11,28 +11,59 @@
 #include <iostream>   // for printing in print() and printNode()
 #include "myvector.hpp" // custom vector used across nodes (children, books)
 #include "book.hpp"     // Book model stored at each category
+#include "stringpool.hpp" // category names are interned
+#include "duplicateindex.hpp" // catalog-wide duplicate lookup kept by the Tree
+#include "tokenindex.hpp" // word index behind keyword search
+#include "titleindex.hpp" // exact title -> (node, book) for findBook/editBook/removeBook
+#include "authorindex.hpp" // ordered authors for exact/prefix findAuthor
+#include "isbnindex.hpp"  // packed ISBN -> book for findISBN
+#include "yearindex.hpp"  // year-ordered buckets for findYear
+#include "slab.hpp"       // pooled Node / Book storage
+#include <unordered_map>  // book -> place
+#include <stdint.h>       // insertion stamps
 
 using namespace std;
 
 // -----------------------------------------------------------------------------
 // Node = one category (or sub-category) in the tree.
-// Owns:
+// Holds (the objects themselves live in the Tree's slab pools):
 //   - children (sub-categories)
 //   - books placed directly in this category
 // Also tracks bookCount = (#books here + #books in all descendants).
 // parent == nullptr only for the root.
+// Wide categories (more than NODE_CHILD_INDEX_THRESHOLD children) also get a
+// name -> child hash index, so path lookups stay O(1) per segment; the
+// children vector keeps insertion order for print/export either way.
+// Under Tree::setUnorderedBooks, big categories likewise get a book -> slot
+// index, so a removal finds its slot without scanning the books.
+// Nodes are also threaded in catalog order (the stack DFS every search uses)
+// and carry an order key that rises along it; the Tree keeps both current.
 // -----------------------------------------------------------------------------
+static const int NODE_CHILD_INDEX_THRESHOLD = 32;
+static const int NODE_BOOK_INDEX_THRESHOLD = 32;
+
 class Node 
 {
 	private:
-		// Display name used in the CLI (e.g., "Computer Science")
-	    string name;
+		// Display name used in the CLI (e.g., "Computer Science"), interned: the
+		// same segment name under many parents is stored once, and sibling
+		// lookups compare ids instead of strings
+	    uint32_t nameId;
+
+		// Sub-categories owned by this node. Most categories have none or one, so
+		// the first two slots live inside the Node (no heap block per category).
+	    SmallVector<Node*, 2> children;
+
+		// Name -> child, built once children passes the threshold (nullptr before)
+	    unordered_map<uint32_t, Node*>* childIndex;
 
-		// Sub-categories owned by this node
-	    MyVector<Node*> children;
+		// Books directly attached to this category (not recursive); the first
+		// four are stored inline, like children
+	    SmallVector<Book*, 4> books;
 
-		// Books directly attached to this category (not recursive)
-	    MyVector<Book*> books;
+		// Book -> slot in 'books' (nullptr unless indexBookSlots() built it). Kept
+		// in step by appends and unordered detaches; an ordered detach drops it.
+	    unordered_map<const Book*, int>* bookSlots;
 
 		// Aggregate count of books in this subtree (kept in sync as we edit)
 	    unsigned int bookCount;
@@ -40,12 +71,21 @@ class Node
 		// Parent pointer (nullptr only for the root node)
 	    Node* parent;
 
+		// Catalog-order thread and key (see Tree::linkInOrder)
+	    Node* prevInOrder;
+	    Node* nextInOrder;
+	    uint64_t orderKey;
+
 	public:
 		// Build a category node and wire its parent (bookCount starts at 0)
 	 	Node(const string& name, Node* parent);
 
+		// Nodes live in one place in the hierarchy (and hold one reference to their name)
+		Node(const Node&) = delete;
+		Node& operator=(const Node&) = delete;
+
 		// Read-only accessors to keep other code tidy
-		string getName() const;
+		const string& getName() const;
 		Node* getParent() const;
 		unsigned int getBookCount() const;
 
@@ -55,27 +95,49 @@ class Node
 		MyVector<Book*>& getBooks();
 		const MyVector<Book*>& getBooks() const;
 
-		// Used by LCMS when renaming a validated category
+		// Used by LCMS when renaming a validated category (keeps the parent's child index in step)
 		void setName(const string& newName);
 
+		// Catalog order: a node's key is smaller than every key after it in the DFS
+		uint64_t getOrderKey() const;
+		void setOrderKey(uint64_t key);
+		Node* getNextInOrder() const;
+
+		// Thread this (unlinked) node in right after 'before'
+		void linkInOrderAfter(Node* before);
+
+		// Unthread this node's whole subtree (one contiguous run of the order)
+		void unlinkSubtreeInOrder();
+
+		// The last node of this subtree in catalog order
+		const Node* lastInSubtree() const;
+
 		// ----- Child/category helpers (local scope only) -----
 
 		// Find an immediate child by name (nullptr if it doesn't exist)
 		Node* findChildByName(const string& childName) const;
 
-		// Ensure a child exists (returns existing if found)
-		Node* addChild(const string& childName);
+		// Link an already-built child (its parent must be this node; caller knows the name is unique)
+		void attachChild(Node* child);
 
-		// Remove a direct child (deletes its whole subtree and fixes counts)
-		bool removeChildByName(const string& childName);
+		// Unlink a direct child and fix counts; the caller (Tree) frees the subtree (nullptr if absent)
+		Node* detachChild(const string& childName);
 
 		// ----- Book helpers (operate on the current node only) -----
 
-		// Add a book here if not a duplicate (also bubbles bookCount up)
-		bool addBook(Book* book);
+		// Add a book with no local duplicate scan (caller already checked the whole catalog)
+		void appendBook(Book* book);
 
-		// Remove first book with a matching title (bubbles count down by 1)
-		bool removeBookByTitle(const string& title);
+		// Unlink the book in slot 'index' (bubbles count down by 1). keepOrder shifts the
+		// later books down; otherwise the last book moves into the hole (O(1)).
+		// The Book itself belongs to the Tree's pool and is not freed here.
+		void detachBookAt(int index, bool keepOrder = true);
+
+		// Build the book -> slot index if this category is big enough to need it
+		void indexBookSlots();
+
+		// Slot of this exact Book* in this category (-1 if it is not here)
+		int indexOfBook(const Book* book) const;
 
 		// Local-only lookup by title (does not search children)
 		Book* findBookHereByTitle(const string& title) const;
@@ -88,7 +150,7 @@ class Node
 		// Append all books in this subtree into 'out'
 		void collectBooksInSubtree(MyVector<Book*>& out) const;
 
-		// Destructor cleans up books here and recursively deletes children
+		// Destructor frees only the child / book-slot indexes (Tree releases books and children)
 		~Node();
 };
 
@@ -98,17 +160,83 @@ class Node
 class Tree 
 {
 	private:
+		// Every Node and Book comes from these pools; releasing a subtree hands its
+		// slots back (and the slabs it emptied, to the heap), and the remaining
+		// slabs go in bulk when the Tree dies. Declared before
+		// root so they are still alive while ~Tree releases the hierarchy.
+	    SlabPool<Node> nodePool;
+	    SlabPool<Book> bookPool;
+
 		// Root category node (owned by the Tree)
 	    Node* root;
 
+		// Duplicate index over every book in the tree (kept in sync by the mutators below)
+	    DuplicateIndex dupIndex;
+
+		// Exact-title index over every book (kept in sync by the mutators below)
+	    TitleIndex titles;
+
+		// ISBN index over every book that has one (kept in sync by the mutators below)
+	    IsbnIndex isbns;
+
+		// True if book 'a' comes before book 'b' in the DFS order of findBook
+	    bool catalogEarlier(const TitlePlace& a, const TitlePlace& b) const;
+
+		// Book removal mode (see setUnorderedBooks)
+	    bool unorderedBooks;
+
+		// Word indexes for find(): book fields (title/author/ISBN/year) and category names.
+		// Built on the first keyword query (so import/load do not pay for them), then
+		// kept in sync by the mutators below.
+	    bool searchReady;
+	    void buildSearchIndex();
+	    TokenIndex<Book> bookTokens;
+	    TokenIndex<Node> categoryTokens;
+	    TokenIndex<Book> authorTokens; // author field alone, for findAuthor
+	    AuthorIndex authors;           // exact / prefix author queries
+	    YearIndex<Node> years;         // publication-year ranges, catalog order within a year
+
+		// Where each book lives, plus an insertion stamp that orders books within a node
+	    struct BookPlace
+	    {
+	        Node* node;
+	        uint64_t order;
+	    };
+	    unordered_map<const Book*, BookPlace> places;
+	    uint64_t nextOrder;
+
+		// Order keys live in [0, ORDER_KEY_LIMIT); the root holds 0
+	    static const uint64_t ORDER_KEY_LIMIT = (uint64_t)1 << 62;
+
+		// Thread a new node in after 'before' and give it a key between its neighbours
+	    void linkInOrder(Node* before, Node* node);
+	    void relabelOrder();
+
+		// Register / unregister one book with every index
+	    void indexBook(Node* node, Book* book);
+	    void indexBookWords(Node* node, Book* book, uint64_t order);
+	    void unindexBook(Book* book);
+
+		// Path string -> node for paths resolved before (import hits the same few
+		// categories row after row). Only hits are cached, so adding categories never
+		// makes an entry wrong; renames and removals drop the whole cache.
+	    mutable unordered_map<string, Node*> pathCache;
+	    void cachePath(const string& path, Node* node) const;
+
 		// Helper for print(): draws nice branch connectors recursively
 	    void printNode(const Node* node, const string& prefix, bool isLast) const;
 
+		// Drop every book under 'node' from the indexes (before the subtree is deleted)
+	    void unindexSubtree(Node* node);
+
+		// Destroy 'node', its descendants and their books, returning the slots to the pools
+	    void releaseSubtree(Node* node);
+
 	public:
 		// Spin up a Tree with a named root category
 		Tree(const string& rootName);
 
-		// Deleting the root frees the entire hierarchy
+		// Releasing the root frees the entire hierarchy
 		~Tree();
 
 		// Let LCMS access the root when necessary
@@ -123,21 +251,51 @@ class Tree
 		// mkdir -p behavior: create missing segments, return final node
 		Node* createNode(const string& path);
 
+		// Add a child under 'parent' without a name check (caller knows it is new)
+		Node* appendChild(Node* parent, const string& name);
+
+		// Rename a category and keep the name index in step
+		void renameNode(Node* node, const string& newName);
+
 		// Remove a category by path (never the root)
 		bool removeNode(const string& path);
 
 		// Render the whole tree in a compact outline form
 		void print() const;
 
-		// DFS for first Book* whose title matches
-		Book* findBook(const string& title) const;
+		// First Book* (in DFS order) whose title matches, via the title index
+		// (optionally reports the node holding it)
+		Book* findBook(const string& title, Node** owner = nullptr) const;
+
+		// The book with this ISBN (hyphens / ISBN-10 vs -13 do not matter), or nullptr
+		Book* findISBN(const string& isbn) const;
 
-		// Ensure categoryPath exists and add the book there
-		bool addBookAt(const string& categoryPath, Book* book);
+		// Ensure categoryPath exists and add a copy of 'values' there
+		Book* addBookAt(const string& categoryPath, const Book& values);
 
-		// DFS remove first matching title anywhere
+		// Store a copy of 'values' in a node unless it duplicates any book in the
+		// catalog; returns the stored Book (owned by the Tree) or nullptr
+		Book* addBook(Node* node, const Book& values);
+
+		// O(1) average duplicate checks against the whole catalog (Book::operator== rule)
+		bool containsBook(const Book& book) const;
+		bool containsBookExcept(const Book& book, const Book* skip) const;
+
+		// Overwrite a stored book's fields with 'values' and re-index it
+		void updateBook(Book* book, const Book& values);
+
+		// Remove the first matching title anywhere
 		bool removeBookByTitle(const string& title);
 
+		// Remove a specific book from the node that holds it
+		bool removeBook(Node* node, Book* book);
+
+		// Opt-in: removing a book moves the category's last book into its slot
+		// instead of shifting every later book (O(1) instead of O(books in the
+		// category)). Listings/exports then show a category's books in insertion
+		// order only until the first removal there.
+		void setUnorderedBooks(bool on);
+
 		// Print categories and books that contain a keyword (substring match)
 		void findKeyword(const string& keyword) const;
 
@@ -146,6 +304,26 @@ class Tree
 
 		// Small wrapper so LCMS can request child removal through Tree
 		bool removeChild(Node* parentNode, const string& childName);
+
+		// Word-index lookup for find(): books and categories that might contain 'keyword'.
+		// False if the keyword has no letters/digits (the caller scans instead).
+		bool keywordCandidates(const string& keyword, MyVector<Book*>& books, MyVector<Node*>& nodes);
+
+		// Same for findAuthor: books whose author might contain 'text'
+		bool authorCandidates(const string& text, MyVector<Book*>& books);
+
+		// Books whose author is exactly / starts with 'text' (case and spacing
+		// normalized), in the order the DFS searches would list them
+		void findAuthorExact(const string& text, MyVector<Book*>& books);
+		void findAuthorPrefix(const string& text, MyVector<Book*>& books);
+
+		// Books published from..to (inclusive) under 'scope' (nullptr = whole catalog),
+		// by year, then in catalog order within a year
+		void findYearRange(int from, int to, const Node* scope, MyVector<Book*>& books);
+
+		// Put books / categories back in the order the DFS searches would list them
+		void sortByCatalogOrder(MyVector<Book*>& books) const;
+		void sortByCatalogOrder(MyVector<Node*>& nodes) const;
 };
 
 // ============================================================================
@@ -154,13 +332,18 @@ class Tree
 
 // Constructor sets up the name, parent pointer, and resets the running count.
 inline Node::Node(const string& name, Node* parent) {
-	this->name = name;
+	nameId = stringPool().intern(name);
 	this->parent = parent;
 	bookCount = 0;
+	childIndex = nullptr;
+	bookSlots = nullptr;
+	prevInOrder = nullptr;
+	nextInOrder = nullptr;
+	orderKey = 0;
 }
 
 // Simple metadata getters (const so they can be used on const nodes)
-inline string Node::getName() const { return name; }
+inline const string& Node::getName() const { return stringPool().text(nameId); }
 inline Node* Node::getParent() const { return parent; }
 inline unsigned int Node::getBookCount() const { return bookCount; }
 
@@ -177,44 +360,89 @@ inline MyVector<Book*>& Node::getBooks() { return books; }
 inline const MyVector<Book*>& Node::getBooks() const { return books; }
 
 // Only called after LCMS validates the new name (to update the name)
-inline void Node::setName(const string& newName) { name = newName; }
+inline void Node::setName(const string& newName) {
+	if (parent != nullptr && parent->childIndex != nullptr) {
+		parent->childIndex->erase(nameId);
+	}
+	uint32_t id = stringPool().intern(newName);
+	stringPool().release(nameId);
+	nameId = id;
+	if (parent != nullptr && parent->childIndex != nullptr) {
+		(*parent->childIndex)[nameId] = this;
+	}
+}
+
+inline uint64_t Node::getOrderKey() const { return orderKey; }
+inline void Node::setOrderKey(uint64_t key) { orderKey = key; }
+inline Node* Node::getNextInOrder() const { return nextInOrder; }
+
+inline void Node::linkInOrderAfter(Node* before) {
+	prevInOrder = before;
+	nextInOrder = before->nextInOrder;
+	before->nextInOrder = this;
+	if (nextInOrder != nullptr) nextInOrder->prevInOrder = this;
+}
+
+inline void Node::unlinkSubtreeInOrder() {
+	Node* last = this;
+	while (!last->children.empty()) last = last->children[0];
+	if (prevInOrder != nullptr) prevInOrder->nextInOrder = last->nextInOrder;
+	if (last->nextInOrder != nullptr) last->nextInOrder->prevInOrder = prevInOrder;
+	prevInOrder = nullptr;
+	last->nextInOrder = nullptr;
+}
 
-// Linear search across immediate children (small n so is suitable for this assignment)
+// The stack DFS visits children last-to-first, so a subtree ends inside its first child
+inline const Node* Node::lastInSubtree() const {
+	const Node* last = this;
+	while (!last->children.empty()) last = last->children[0];
+	return last;
+}
+
+// Hash lookup for wide categories, else a linear id scan (narrow ones are the common case)
+// (a name that was never interned cannot belong to any child)
 inline Node* Node::findChildByName(const string& childName) const {
-	for (int i = 0; i < children.size(); i++){
-		if (children[i]->getName() == childName) return children[i];
+	uint32_t id;
+	if (!stringPool().find(childName, id)) return nullptr;
+	if (childIndex != nullptr) {
+		unordered_map<uint32_t, Node*>::const_iterator it = childIndex->find(id);
+		return (it == childIndex->end()) ? nullptr : it->second;
+	}
+	for (size_t i = 0; i < children.size(); i++){
+		if (children[i]->nameId == id) return children[i];
 	}
 	return nullptr;	
 }
 
-// Create-or-return child; keeps the tree tidy without duplicates (if the child already exists, return it)
-inline Node* Node::addChild(const string& childName) {
-	Node* exists = findChildByName(childName);
-	if (exists != nullptr) return exists;
-
-	Node* child = new Node(childName, this);
+// Tree::appendChild builds the Node from its pool, then links it here
+inline void Node::attachChild(Node* child) {
 	children.push_back(child);
-	return child;
+	if (childIndex != nullptr) {
+		(*childIndex)[child->nameId] = child;
+	} else if (children.size() > NODE_CHILD_INDEX_THRESHOLD) {
+		childIndex = new unordered_map<uint32_t, Node*>();
+		childIndex->reserve(children.size() * 2);
+		for (size_t i = 0; i < children.size(); ++i) (*childIndex)[children[i]->nameId] = children[i];
+	}
 }
 
-// Remove a direct child and decrement bookCount along the parent chain
-inline bool Node::removeChildByName(const string& childName) {
-	// Find which slot to remove (if the child doesn't exist, return false)
+// Unlink a direct child and decrement bookCount along the parent chain
+inline Node* Node::detachChild(const string& childName) {
+	// Find which slot to remove (if the child doesn't exist, return nullptr)
+	Node* doomed = findChildByName(childName);
+	if (doomed == nullptr) return nullptr;
 	int idx = -1;
-	for (int i = 0; i < children.size(); ++i) {
-		if (children[i]->getName() == childName) {
+	for (size_t i = 0; i < children.size(); ++i) {
+		if (children[i] == doomed) {
 			idx = i;
 			break;
 		}
 	}
-	if (idx == -1) return false;
+	if (childIndex != nullptr) childIndex->erase(doomed->nameId);
 
 	// Remember how many books lived in that subtree (to decrement the bookCount)
 	unsigned int delta = children[idx]->getBookCount();
 
-	// Drop the entire subtree (child destructor frees its own children & books)
-	delete children[idx];
-
 	// Close the hole in the children vector (to maintain the order)
 	children.removeAt(idx);
 
@@ -224,15 +452,13 @@ inline bool Node::removeChildByName(const string& childName) {
 		p->bookCount -= delta;
 		p = p->parent;
 	}
-	return true;
+	return doomed;
 }
 
-// Add a book here if local-duplicate check passes (also updates counts upward)
-inline bool Node::addBook(Book* book) {
-	for (int i = 0; i < books.size(); ++i) {
-		if (*(books[i]) == *book) return false; // duplicate in this category
-	}
+// Append without the local scan (Tree::addBook already ran the global check)
+inline void Node::appendBook(Book* book) {
 	books.push_back(book);
+	if (bookSlots != nullptr) (*bookSlots)[book] = (int)books.size() - 1;
 
 	// Increment counts up the chain
 	Node* p = this;
@@ -240,21 +466,38 @@ inline bool Node::addBook(Book* book) {
 		p->bookCount += 1;
 		p = p->parent;
 	}
-	return true;
 }
 
-// Remove the first title match from this category only (and update counts)
-inline bool Node::removeBookByTitle(const string& title) {
-	// Find which slot to remove (if the book doesn't exist, return false)
-	int idx = -1;
-	for (int i = 0; i < books.size(); ++i) {
-		if (books[i]->getTitle() == title) { idx = i; break; }
+inline void Node::indexBookSlots() {
+	if (bookSlots != nullptr || books.size() <= NODE_BOOK_INDEX_THRESHOLD) return;
+	bookSlots = new unordered_map<const Book*, int>();
+	bookSlots->reserve(books.size() * 2);
+	for (size_t i = 0; i < books.size(); ++i) (*bookSlots)[books[i]] = (int)i;
+}
+
+inline int Node::indexOfBook(const Book* book) const {
+	if (bookSlots != nullptr) {
+		unordered_map<const Book*, int>::const_iterator it = bookSlots->find(book);
+		return (it == bookSlots->end()) ? -1 : it->second;
+	}
+	for (size_t i = 0; i < books.size(); ++i) {
+		if (books[i] == book) return i;
 	}
-	if (idx == -1) return false;
+	return -1;
+}
 
-	// We own the Book*, so delete it here (to free the memory)
-	delete books[idx];
-	books.removeAt(idx);
+inline void Node::detachBookAt(int index, bool keepOrder) {
+	if (keepOrder) {
+		books.removeAt(index);
+		delete bookSlots; // every later slot moved; a scan is as cheap as fixing them
+		bookSlots = nullptr;
+	} else {
+		if (bookSlots != nullptr) {
+			bookSlots->erase(books[index]);
+			if (index != (int)books.size() - 1) (*bookSlots)[books[books.size() - 1]] = index;
+		}
+		books.swap_remove(index);
+	}
 
 	// Decrement counts up the chain (to decrement the bookCount)
 	Node* p = this;
@@ -262,12 +505,11 @@ inline bool Node::removeBookByTitle(const string& title) {
 		p->bookCount -= 1;
 		p = p->parent;
 	}
-	return true;
 }
 
 // Local-only lookup by title (does not recurse into children) (if the book doesn't exist, return nullptr)
 inline Book* Node::findBookHereByTitle(const string& title) const {
-	for (int i = 0; i < books.size(); ++i) {
+	for (size_t i = 0; i < books.size(); ++i) {
 		if (books[i]->getTitle() == title) return books[i];
 	}
 	return nullptr;
@@ -277,30 +519,32 @@ inline Book* Node::findBookHereByTitle(const string& title) const {
 inline void Node::print(int depth) const {
 	// 2 spaces per depth level (to indent the tree)
 	for (int i = 0; i < depth; ++i) cout << "  ";
-	cout << "- " << name << " (books=" << bookCount << ")\n";
+	cout << "- " << getName() << " (books=" << bookCount << ")\n";
 
 	// Show titles directly under this category (to print the books)
-	for (int i = 0; i < books.size(); ++i) {
+	for (size_t i = 0; i < books.size(); ++i) {
 		for (int j = 0; j < depth + 1; ++j) cout << "  ";
 		cout << "* " << books[i]->getTitle() << "\n";
 	}
 
 	// Recurse into sub-categories
-	for (int i = 0; i < children.size(); ++i) {
+	for (size_t i = 0; i < children.size(); ++i) {
 		children[i]->print(depth + 1);
 	}
 }
 
 // Append all books in this subtree to 'out' (preorder)
 inline void Node::collectBooksInSubtree(MyVector<Book*>& out) const {
-	for (int i = 0; i < books.size(); ++i) out.push_back(books[i]);
-	for (int i = 0; i < children.size(); ++i) children[i]->collectBooksInSubtree(out);
+	for (size_t i = 0; i < books.size(); ++i) out.push_back(books[i]);
+	for (size_t i = 0; i < children.size(); ++i) children[i]->collectBooksInSubtree(out);
 }
 
-// Destructor: delete local books, then recursively delete each child subtree
+// Destructor: books and children live in the Tree's pools (Tree::releaseSubtree frees them);
+// only the name reference and the lookup tables go with the node
 inline Node::~Node() {
-	for (int i = 0; i < books.size(); ++i) delete books[i];
-	for (int i = 0; i < children.size(); ++i) delete children[i];
+	stringPool().release(nameId);
+	delete childIndex;
+	delete bookSlots;
 }
 
 // ============================================================================
@@ -312,12 +556,15 @@ inline Node::~Node() {
 
 // Build a tree with a named root category
 inline Tree::Tree(const string& rootName) {
-	root = new Node(rootName, nullptr);
+	root = nodePool.create(rootName, nullptr);
+	nextOrder = 0;
+	searchReady = false;
+	unorderedBooks = false;
 }
 
-// Delete the root; Node::~Node handles full recursive cleanup
+// Release the whole hierarchy; the pools then free their slabs in bulk
 inline Tree::~Tree() {
-	delete root;
+	releaseSubtree(root);
 	root = nullptr;
 }
 
@@ -336,14 +583,14 @@ inline void Tree::splitPath(const string& path, MyVector<string>& parts) const {
 		char c = path[i];
 		if (c == '/') {
 			if (current.size() > 0) {
-				parts.push_back(current);
-				current = "";
+				parts.push_back(std::move(current));
+				current.clear();
 			}
 		} else {
 			current += c;
 		}
 	}
-	if (current.size() > 0) parts.push_back(current);
+	if (current.size() > 0) parts.push_back(std::move(current));
 }
 
 // Follow a path from root; return nullptr as soon as a segment is missing
@@ -351,33 +598,101 @@ inline Node* Tree::getNode(const string& path) const {
 	if (!root) return nullptr;
 	if (path.size() == 0 || path == "/") return root;
 
+	unordered_map<string, Node*>::const_iterator hit = pathCache.find(path);
+	if (hit != pathCache.end()) return hit->second;
+
 	MyVector<string> parts;
 	splitPath(path, parts);
 
 	Node* cur = root;
-	for (int i = 0; i < parts.size(); ++i) {
+	for (size_t i = 0; i < parts.size(); ++i) {
 		Node* next = cur->findChildByName(parts[i]);
 		if (!next) return nullptr;
 		cur = next;
 	}
+	cachePath(path, cur);
 	return cur;
 }
 
+// Bounded so a stream of one-off paths can't grow it forever
+inline void Tree::cachePath(const string& path, Node* node) const {
+	if (pathCache.size() >= 65536) pathCache.clear();
+	pathCache[path] = node;
+}
+
 // mkdir -p style creation: create any missing nodes along the path
 inline Node* Tree::createNode(const string& path) {
 	if (!root) return nullptr;
 	if (path.size() == 0 || path == "/") return root;
 
+	unordered_map<string, Node*>::const_iterator hit = pathCache.find(path);
+	if (hit != pathCache.end()) return hit->second;
+
 	MyVector<string> parts;
 	splitPath(path, parts);
 
 	Node* cur = root;
-	for (int i = 0; i < parts.size(); ++i) {
-		cur = cur->addChild(parts[i]); // addChild is idempotent
+	for (size_t i = 0; i < parts.size(); ++i) {
+		Node* next = cur->findChildByName(parts[i]);
+		cur = next ? next : appendChild(cur, parts[i]);
 	}
+	cachePath(path, cur);
 	return cur;
 }
 
+// New categories go through here so the name index and catalog order stay current.
+// A new last child is the first child the stack DFS pops, so it comes right after its parent.
+inline Node* Tree::appendChild(Node* parent, const string& name) {
+	Node* child = nodePool.create(name, parent);
+	parent->attachChild(child);
+	linkInOrder(parent, child);
+	if (searchReady) categoryTokens.add(child, name);
+	return child;
+}
+
+// Order-maintenance labelling (Dietz): the new node and the m-1 nodes after it
+// are spread evenly over the gap up to the next node, for the smallest m whose
+// gap exceeds m*m. Usually m = 1 (the midpoint); crowded spots relabel a short
+// run, so appends cost O(log n) amortized instead of renumbering the catalog.
+inline void Tree::linkInOrder(Node* before, Node* node) {
+	node->linkInOrderAfter(before);
+	uint64_t low = before->getOrderKey();
+	uint64_t m = 1;
+	Node* bound = node->getNextInOrder();
+	for (;;) {
+		uint64_t high = (bound != nullptr) ? bound->getOrderKey() : ORDER_KEY_LIMIT;
+		if (high - low > m * m) {
+			uint64_t step = (high - low) / (m + 1);
+			Node* cur = node;
+			for (uint64_t i = 1; i <= m; ++i, cur = cur->getNextInOrder()) cur->setOrderKey(low + i * step);
+			return;
+		}
+		if (bound == nullptr) break;
+		bound = bound->getNextInOrder();
+		m++;
+	}
+	relabelOrder(); // key space used up (not reachable in practice): spread everyone out
+}
+
+inline void Tree::relabelOrder() {
+	uint64_t count = 0;
+	for (Node* cur = root; cur != nullptr; cur = cur->getNextInOrder()) count++;
+	uint64_t step = ORDER_KEY_LIMIT / count;
+	uint64_t key = 0;
+	for (Node* cur = root; cur != nullptr; cur = cur->getNextInOrder(), key += step) cur->setOrderKey(key);
+}
+
+// The root is never listed as a category match, so it is not indexed
+inline void Tree::renameNode(Node* node, const string& newName) {
+	if (!node) return;
+	if (searchReady && node != root) {
+		categoryTokens.remove(node);
+		categoryTokens.add(node, newName);
+	}
+	node->setName(newName);
+	pathCache.clear(); // every cached path through this node is stale
+}
+
 // Remove a category by path (refuses to remove the root)
 inline bool Tree::removeNode(const string& path) {
 	if (!root) return false;
@@ -390,7 +705,7 @@ inline bool Tree::removeNode(const string& path) {
 	// Build parent path (everything except the last segment)
 	string last = parts[parts.size() - 1];
 	string parentPath = "";
-	for (int i = 0; i < parts.size() - 1; ++i) {
+	for (size_t i = 0; i < parts.size() - 1; ++i) {
 		if (i > 0) parentPath += "/";
 		parentPath += parts[i];
 	}
@@ -399,7 +714,7 @@ inline bool Tree::removeNode(const string& path) {
 	Node* parentNode = (parentPath.size() == 0) ? root : getNode(parentPath);
 	if (!parentNode) return false;
 
-	return parentNode->removeChildByName(last);
+	return removeChild(parentNode, last);
 }
 
 // Print the whole tree using a compact outline (root header + recursive branches)
@@ -411,7 +726,7 @@ inline void Tree::print() const {
 
 	// Then pretty-print each child with connectors (to print the tree)
 	const MyVector<Node*>& kids = root->getChildren();
-	for (int i = 0; i < kids.size(); ++i) {
+	for (size_t i = 0; i < kids.size(); ++i) {
 		bool isLast = (i == kids.size() - 1);
 		printNode(kids[i], "", isLast);
 	}
@@ -430,59 +745,158 @@ inline void Tree::printNode(const Node* node, const string& prefix, bool isLast)
 	string nextPrefix = prefix + spacer;
 
 	const MyVector<Node*>& kids = node->getChildren();
-	for (int i = 0; i < kids.size(); ++i) {
+	for (size_t i = 0; i < kids.size(); ++i) {
 		bool childIsLast = (i == kids.size() - 1);
 		printNode(kids[i], nextPrefix, childIsLast);
 	}
 }
 
 // DFS for first book whose title matches (to find the book)
-inline Book* Tree::findBook(const string& title) const {
-	if (!root) return nullptr;
-
-	MyVector<Node*> stack;
-	stack.push_back(root);
-
-	while (!stack.empty()) {
-		int last = stack.size() - 1;
-		Node* cur = stack[last];
-		stack.removeAt(last);
+inline Book* Tree::findBook(const string& title, Node** owner) const {
+	MyVector<TitlePlace> hits;
+	int count = titles.lookup(title, hits);
+	if (count == 0) return nullptr;
+
+	// Several books share the title: answer the one the DFS would reach first
+	int best = 0;
+	for (int i = 1; i < count; ++i) {
+		if (catalogEarlier(hits[i], hits[best])) best = i;
+	}
+	if (owner) *owner = hits[best].node;
+	return hits[best].book;
+}
 
-		Book* here = cur->findBookHereByTitle(title);
-		if (here) return here;
+inline Book* Tree::findISBN(const string& isbn) const {
+	return isbns.find(isbn);
+}
 
-		const MyVector<Node*>& kids = cur->getChildren();
-		for (int i = 0; i < kids.size(); ++i) stack.push_back(kids[i]);
+// DFS order: the node's order key first, then the book's slot inside the node
+inline bool Tree::catalogEarlier(const TitlePlace& a, const TitlePlace& b) const {
+	if (a.node != b.node) {
+		return a.node->getOrderKey() < b.node->getOrderKey();
 	}
-	return nullptr;
+	return a.node->indexOfBook(a.book) < a.node->indexOfBook(b.book);
 }
 
 // Ensure category exists and add the book there (to add the book to the category)
-inline bool Tree::addBookAt(const string& categoryPath, Book* book) {
-	if (!root || !book) return false;
+inline Book* Tree::addBookAt(const string& categoryPath, const Book& values) {
+	if (!root) return nullptr;
 	Node* node = createNode(categoryPath);
-	if (!node) return false;
-	return node->addBook(book);
+	if (!node) return nullptr;
+	return addBook(node, values);
 }
 
-// DFS remove first matching title anywhere (to remove the book from the category)
-inline bool Tree::removeBookByTitle(const string& title) {
-	if (!root) return false;
+// Global duplicate check through the index, then copy into a pooled Book, append and index it
+inline Book* Tree::addBook(Node* node, const Book& values) {
+	if (!node) return nullptr;
+	if (dupIndex.contains(values)) return nullptr;
+	Book* book = bookPool.create(values);
+	node->appendBook(book);
+	indexBook(node, book);
+	return book;
+}
 
-	MyVector<Node*> stack;
-	stack.push_back(root);
+inline void Tree::indexBook(Node* node, Book* book) {
+	dupIndex.add(*book);
+	titles.add(book->getTitle(), node, book);
+	isbns.add(book);
+	if (searchReady) indexBookWords(node, book, nextOrder++);
+}
 
-	while (!stack.empty()) {
-		int last = stack.size() - 1;
-		Node* cur = stack[last];
-		stack.removeAt(last);
+// 'order' is the book's stamp inside its node (a new one, or the one it keeps across an edit)
+inline void Tree::indexBookWords(Node* node, Book* book, uint64_t order) {
+	bookTokens.add(book, book->getTitle());
+	bookTokens.add(book, book->getAuthor());
+	bookTokens.add(book, book->getISBN());
+	bookTokens.add(book, to_string(book->getYear()));
+	authorTokens.add(book, book->getAuthor());
+	authors.add(book);
+	years.add(book, node, order);
+	BookPlace place = BookPlace();
+	place.node = node;
+	place.order = order;
+	places[book] = place;
+}
+
+inline void Tree::unindexBook(Book* book) {
+	dupIndex.remove(*book);
+	isbns.remove(book);
+	titles.remove(book->getTitle(), book);
+	if (!searchReady) return;
+	bookTokens.remove(book);
+	authorTokens.remove(book);
+	authors.remove(book);
+	unordered_map<const Book*, BookPlace>::iterator place = places.find(book);
+	years.remove(book, place->second.node, place->second.order);
+	places.erase(place);
+}
+
+inline bool Tree::containsBook(const Book& book) const {
+	return dupIndex.contains(book);
+}
+
+inline bool Tree::containsBookExcept(const Book& book, const Book* skip) const {
+	return dupIndex.containsExcept(book, skip);
+}
 
-		if (cur->removeBookByTitle(title)) return true;
+// Unindex under the old values, copy the new ones in, then index again
+inline void Tree::updateBook(Book* book, const Book& values) {
+	if (!book) return;
+	dupIndex.remove(*book);
+	Node* node = titles.remove(book->getTitle(), book);
+	isbns.remove(book);
+	BookPlace place = BookPlace();
+	if (searchReady) {
+		place = places[book]; // an edit keeps the book's slot in its node
+		bookTokens.remove(book);
+		authorTokens.remove(book);
+		authors.remove(book);
+		years.remove(book, place.node, place.order);
+	}
+	book->setTitle(values.getTitle());
+	book->setAuthor(values.getAuthor());
+	book->setISBN(values.getISBN());
+	book->setYear(values.getYear());
+	dupIndex.add(*book);
+	titles.add(book->getTitle(), node, book);
+	isbns.add(book);
+	if (searchReady) indexBookWords(place.node, book, place.order);
+}
+
+// Remove the first matching title anywhere (to remove the book from the category)
+inline bool Tree::removeBookByTitle(const string& title) {
+	Node* owner = nullptr;
+	Book* book = findBook(title, &owner);
+	return book != nullptr && removeBook(owner, book);
+}
 
-		MyVector<Node*>& kids = cur->getChildren(); // non-const in case we later mutate
-		for (int i = 0; i < kids.size(); ++i) stack.push_back(kids[i]);
+// Unindex first, unlink it from the node, then hand its slot back to the pool
+inline bool Tree::removeBook(Node* node, Book* book) {
+	if (!node || !book) return false;
+	if (unorderedBooks) node->indexBookSlots();
+	int slot = node->indexOfBook(book);
+	if (slot == -1) return false;
+
+	// Unordered: the category's last book takes over this slot, and its stamp, so
+	// stamps still rise with slots and catalog order stays the vector order (the
+	// year index files the moved book under its new stamp)
+	int last = (int)node->getBooks().size() - 1;
+	Book* moved = (unorderedBooks && searchReady && slot != last) ? node->getBooks()[last] : nullptr;
+	uint64_t freedOrder = (moved != nullptr) ? places[book].order : 0;
+	unindexBook(book);
+	if (moved != nullptr) {
+		BookPlace& place = places[moved];
+		years.remove(moved, node, place.order);
+		place.order = freedOrder;
+		years.add(moved, node, place.order);
 	}
-	return false;
+	node->detachBookAt(slot, !unorderedBooks);
+	bookPool.destroy(book);
+	return true;
+}
+
+inline void Tree::setUnorderedBooks(bool on) {
+	unorderedBooks = on;
 }
 
 // Print categories + books containing the keyword (simple substring match)
@@ -493,9 +907,7 @@ inline void Tree::findKeyword(const string& keyword) const {
 	stack.push_back(root);
 
 	while (!stack.empty()) {
-		int last = stack.size() - 1;
-		Node* cur = stack[last];
-		stack.removeAt(last);
+		Node* cur = stack.pop_back();
 
 		// Category name match
 		if (cur->getName().find(keyword) != string::npos) {
@@ -504,7 +916,7 @@ inline void Tree::findKeyword(const string& keyword) const {
 
 		// Book field match (title/author/isbn/year)
 		const MyVector<Book*>& bvec = cur->getBooks();
-		for (int i = 0; i < bvec.size(); ++i) {
+		for (size_t i = 0; i < bvec.size(); ++i) {
 			Book* b = bvec[i];
 			bool match =
 				(b->getTitle().find(keyword)  != string::npos) ||
@@ -519,7 +931,7 @@ inline void Tree::findKeyword(const string& keyword) const {
 
 		// Continue DFS
 		const MyVector<Node*>& kids = cur->getChildren();
-		for (int i = 0; i < kids.size(); ++i) stack.push_back(kids[i]);
+		for (size_t i = 0; i < kids.size(); ++i) stack.push_back(kids[i]);
 	}
 }
 
@@ -541,7 +953,7 @@ inline void Tree::listAllBooksIn(const string& categoryPath) const {
 	MyVector<Book*> collected;
 	start->collectBooksInSubtree(collected);
 
-	for (int i = 0; i < collected.size(); ++i) {
+	for (size_t i = 0; i < collected.size(); ++i) {
 		collected[i]->printBook();
 	}
 }
@@ -549,7 +961,125 @@ inline void Tree::listAllBooksIn(const string& categoryPath) const {
 // Small wrapper so LCMS can remove a child via Tree without touching Node directly
 inline bool Tree::removeChild(Node* parentNode, const string& childName) {
 	if (!parentNode) return false;
-	return parentNode->removeChildByName(childName);
+	Node* child = parentNode->findChildByName(childName);
+	if (!child) return false;
+	unindexSubtree(child);
+	pathCache.clear(); // entries may point into the doomed subtree
+	child->unlinkSubtreeInOrder();
+	parentNode->detachChild(childName);
+	releaseSubtree(child);
+	nodePool.releaseEmptySlabs(); // slabs the subtree emptied go back to the heap now
+	bookPool.releaseEmptySlabs();
+	return true;
+}
+
+// Walk the doomed subtree and take each of its books and categories out of the indexes
+inline void Tree::unindexSubtree(Node* node) {
+	MyVector<Book*> doomed;
+	node->collectBooksInSubtree(doomed);
+	for (size_t i = 0; i < doomed.size(); ++i) unindexBook(doomed[i]);
+	if (!searchReady) return;
+
+	MyVector<Node*> stack;
+	stack.push_back(node);
+	while (!stack.empty()) {
+		Node* cur = stack.pop_back();
+		categoryTokens.remove(cur);
+		const MyVector<Node*>& kids = cur->getChildren();
+		for (size_t i = 0; i < kids.size(); ++i) stack.push_back(kids[i]);
+	}
+}
+
+// Iterative, so a deep hierarchy cannot overflow the stack. Every slot goes
+// back to its slab's free list (no per-object free), ready for the next import;
+// removeChild then lets the pools return the slabs left empty.
+inline void Tree::releaseSubtree(Node* node) {
+	if (!node) return;
+	MyVector<Node*> stack;
+	stack.push_back(node);
+	while (!stack.empty()) {
+		Node* cur = stack.pop_back();
+		const MyVector<Book*>& books = cur->getBooks();
+		for (size_t i = 0; i < books.size(); ++i) bookPool.destroy(books[i]);
+		const MyVector<Node*>& kids = cur->getChildren();
+		for (size_t i = 0; i < kids.size(); ++i) stack.push_back(kids[i]);
+		nodePool.destroy(cur);
+	}
+}
+
+// One pass over the whole tree; books keep their in-node order through the stamps
+inline void Tree::buildSearchIndex() {
+	searchReady = true;
+	MyVector<Node*> stack;
+	stack.push_back(root);
+	while (!stack.empty()) {
+		Node* cur = stack.pop_back();
+		if (cur != root) categoryTokens.add(cur, cur->getName());
+		const MyVector<Book*>& local = cur->getBooks();
+		for (size_t i = 0; i < local.size(); ++i) indexBookWords(cur, local[i], nextOrder++);
+		const MyVector<Node*>& kids = cur->getChildren();
+		for (size_t i = 0; i < kids.size(); ++i) stack.push_back(kids[i]);
+	}
+}
+
+inline bool Tree::keywordCandidates(const string& keyword, MyVector<Book*>& books, MyVector<Node*>& nodes) {
+	if (!searchReady) buildSearchIndex();
+	if (!bookTokens.candidates(keyword, books)) return false;
+	categoryTokens.candidates(keyword, nodes);
+	return true;
+}
+
+inline bool Tree::authorCandidates(const string& text, MyVector<Book*>& books) {
+	if (!searchReady) buildSearchIndex();
+	return authorTokens.candidates(text, books);
+}
+
+inline void Tree::findAuthorExact(const string& text, MyVector<Book*>& books) {
+	if (!searchReady) buildSearchIndex();
+	authors.exact(text, books);
+	sortByCatalogOrder(books);
+}
+
+inline void Tree::findAuthorPrefix(const string& text, MyVector<Book*>& books) {
+	if (!searchReady) buildSearchIndex();
+	authors.prefix(text, books);
+	sortByCatalogOrder(books);
+}
+
+// A subtree is the run of order keys from its root to its last node, so each
+// year costs one seek plus the books actually in scope
+inline void Tree::findYearRange(int from, int to, const Node* scope, MyVector<Book*>& books) {
+	if (!searchReady) buildSearchIndex();
+	if (scope == root) scope = nullptr;
+	uint64_t lastKey = (scope != nullptr) ? scope->lastInSubtree()->getOrderKey() : 0;
+	years.collect(from, to, scope, lastKey, books);
+}
+
+// Books: by their node's order key, then by position inside the node (insertion stamp)
+inline void Tree::sortByCatalogOrder(MyVector<Book*>& books) const {
+	if (books.size() < 2) return;
+	struct Keyed { uint64_t nodeKey; uint64_t order; Book* book; };
+	MyVector<Keyed> keyed;
+	keyed.reserve(books.size());
+	for (size_t i = 0; i < books.size(); ++i) {
+		const BookPlace& place = places.find(books[i])->second;
+		Keyed k;
+		k.nodeKey = place.node->getOrderKey();
+		k.order = place.order;
+		k.book = books[i];
+		keyed.push_back(k);
+	}
+	sort(keyed.begin(), keyed.end(), [](const Keyed& a, const Keyed& b) {
+		return a.nodeKey != b.nodeKey ? a.nodeKey < b.nodeKey : a.order < b.order;
+	});
+	for (size_t i = 0; i < keyed.size(); ++i) books[i] = keyed[i].book;
+}
+
+inline void Tree::sortByCatalogOrder(MyVector<Node*>& nodes) const {
+	if (nodes.size() < 2) return;
+	sort(nodes.begin(), nodes.end(), [](const Node* a, const Node* b) {
+		return a->getOrderKey() < b->getOrderKey();
+	});
 }
 
 // -----------------------------------------------------------------------------
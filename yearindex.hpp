@@ -0,0 +1,120 @@
+#ifndef _YEARINDEX_H
+#define _YEARINDEX_H
+
+// -----------------------------------------------------------------------------
+// Library Catalog Project — YearIndex (publication year -> books, in year order).
+// find only matches years as text, so "everything from 1950 to 1970" meant
+// scanning the catalog. Books are bucketed per year in an ordered map, and each
+// bucket keeps its books in catalog order: by their category's order key, then
+// by their insertion stamp inside the category. A category's subtree is one
+// run of that order, so a scoped query seeks to the subtree's first key in each
+// year (O(log k)) and walks only the books that match.
+// N is the category type (Tree uses Node); it must provide getOrderKey().
+// Keys may be relabelled while books are indexed: relabelling never changes
+// their relative order, so the buckets stay sorted.
+// I use inline functions so that the function definitions inside the header file don’t cause linker errors when the header is included in multiple source files
+// Source: https://stackoverflow.com/questions/5057021/why-do-inline-functions-have-to-be-defined-in-a-header-file
+// -----------------------------------------------------------------------------
+
+#include <map>            // ordered years
+#include <set>            // one bucket per year, in catalog order
+#include <stdint.h>       // order keys and stamps
+#include "myvector.hpp"   // query results
+#include "book.hpp"       // Book model
+
+using namespace std;
+
+template <typename N>
+class YearIndex
+{
+	private:
+		// One indexed book: where it sits in the catalog, and the book itself
+		struct Entry
+		{
+			const N* node;
+			uint64_t order;
+			Book* book;
+		};
+
+		// Catalog order (the node's current key, then the stamp inside the node)
+		struct CatalogLess
+		{
+			bool operator()(const Entry& a, const Entry& b) const {
+				uint64_t ka = a.node->getOrderKey();
+				uint64_t kb = b.node->getOrderKey();
+				return ka != kb ? ka < kb : a.order < b.order;
+			}
+		};
+
+		typedef set<Entry, CatalogLess> Bucket;
+
+		// Year -> the books published that year
+		map<int, Bucket> byYear;
+
+		static Entry makeEntry(Book* book, const N* node, uint64_t order);
+
+	public:
+		// Register / unregister a book under its current year, at its place in
+		// the catalog (the same node and stamp for both calls)
+		void add(Book* book, const N* node, uint64_t order);
+		void remove(Book* book, const N* node, uint64_t order);
+
+		// Forget everything
+		void clear();
+
+		// Append books published from..to (inclusive), by year and in catalog order
+		// within a year. With 'first' set, only books whose node key lies in
+		// [first's key, lastKey] (one subtree) are visited.
+		void collect(int from, int to, const N* first, uint64_t lastKey, MyVector<Book*>& out) const;
+};
+
+// ============================================================================
+// YearIndex methods
+// ============================================================================
+
+template <typename N>
+inline typename YearIndex<N>::Entry YearIndex<N>::makeEntry(Book* book, const N* node, uint64_t order) {
+	Entry e;
+	e.node = node;
+	e.order = order;
+	e.book = book;
+	return e;
+}
+
+template <typename N>
+inline void YearIndex<N>::add(Book* book, const N* node, uint64_t order) {
+	byYear[book->getYear()].insert(makeEntry(book, node, order));
+}
+
+// Drop the year once its last book is gone so range walks stay tight
+template <typename N>
+inline void YearIndex<N>::remove(Book* book, const N* node, uint64_t order) {
+	typename map<int, Bucket>::iterator it = byYear.find(book->getYear());
+	if (it == byYear.end()) return;
+	it->second.erase(makeEntry(book, node, order));
+	if (it->second.empty()) byYear.erase(it);
+}
+
+template <typename N>
+inline void YearIndex<N>::clear() {
+	byYear.clear();
+}
+
+template <typename N>
+inline void YearIndex<N>::collect(int from, int to, const N* first, uint64_t lastKey, MyVector<Book*>& out) const {
+	typename map<int, Bucket>::const_iterator it = byYear.lower_bound(from);
+	for (; it != byYear.end() && it->first <= to; ++it) {
+		const Bucket& bucket = it->second;
+		typename Bucket::const_iterator e = bucket.begin();
+		if (first != nullptr) e = bucket.lower_bound(makeEntry(nullptr, first, 0));
+		for (; e != bucket.end(); ++e) {
+			if (first != nullptr && e->node->getOrderKey() > lastKey) break;
+			out.push_back(e->book);
+		}
+	}
+}
+
+// -----------------------------------------------------------------------------
+// End guard: keep headers clean and avoid accidental extra code below.
+// -----------------------------------------------------------------------------
+#endif